@@ -0,0 +1,375 @@
+#include "alloc.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file bench.c
+ * @brief Throughput / latency harness for the allocators, with system malloc
+ * as the baseline.
+ *
+ * Scenarios:
+ * - arena storm:  bump-allocation bursts released all at once
+ * - pool churn:   steady alloc/free mix at several size distributions
+ * - pool frag:    fragmentation-inducing interleave (free every other, then
+ *                 allocate larger runs)
+ * - arena mt:     concurrent bump allocation on the sharded arena
+ * - trace replay: `bench trace <file>` consumes a recorded allocation log of
+ *                 lines "a <id> <size>" and "f <id>"
+ *
+ * Each scenario reports ops/sec plus p50/p99 latency sampled per operation.
+ */
+
+typedef u64 (*bench_op)(void* ctx, u64 i);
+
+#define S_SAMPLES ((u64)1 << 16)
+
+static u64 samples[S_SAMPLES];
+
+static u64 bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static int bench_cmp_u64(const void* a, const void* b) {
+  const u64 x = *(const u64*)a, y = *(const u64*)b;
+  return x < y ? -1 : x > y;
+}
+
+// runs `ops` iterations of `op`, sampling per-op latency, and prints one row
+static void bench_run(const char* name, bench_op op, void* ctx, const u64 ops) {
+  const u64 stride = ops / S_SAMPLES > 0 ? ops / S_SAMPLES : 1;
+  u64 n_samples = 0;
+
+  const u64 t0 = bench_now_ns();
+
+  for (u64 i = 0; i < ops; i++) {
+    if (i % stride == 0 && n_samples < S_SAMPLES) {
+      const u64 s0 = bench_now_ns();
+      op(ctx, i);
+      samples[n_samples++] = bench_now_ns() - s0;
+    } else {
+      op(ctx, i);
+    }
+  }
+
+  const u64 elapsed = bench_now_ns() - t0;
+
+  qsort(samples, n_samples, sizeof(u64), bench_cmp_u64);
+
+  printf(
+    "%-28s %12.0f ops/s   p50 %6zu ns   p99 %6zu ns\n",
+    name,
+    elapsed > 0 ? (f64)ops * 1e9 / (f64)elapsed : 0.0,
+    samples[n_samples / 2],
+    samples[(u64)((f64)n_samples * 0.99)]
+  );
+}
+
+// ------------------------------- arena storm --------------------------------
+
+typedef struct { Arena* arena; u64 s_alloc, batch; } storm_ctx;
+
+static u64 op_arena_storm(void* ctx, u64 i) {
+  storm_ctx* c = ctx;
+
+  if (i % c->batch == c->batch - 1)
+    arena_reset_fast(c->arena);
+
+  void* p = arena_alloc(c->arena, c->s_alloc);
+  return (u64)(uintptr_t)p;
+}
+
+static u64 op_malloc_storm(void* ctx, u64 i) {
+  storm_ctx* c = ctx;
+  static void* held[4096];
+
+  const u64 slot = i % c->batch % 4096;
+  free(held[slot]);
+  held[slot] = malloc(c->s_alloc);
+
+  return (u64)(uintptr_t)held[slot];
+}
+
+// ------------------------------- pool churn ---------------------------------
+
+typedef struct {
+  Pool* pool;
+  u64 s_min, s_max;
+  void* held[4096];
+  u64 sizes[4096];
+  u64 seed;
+} churn_ctx;
+
+static u64 churn_rand(churn_ctx* c) {
+  // xorshift64: cheap, deterministic across runs
+  c->seed ^= c->seed << 13;
+  c->seed ^= c->seed >> 7;
+  c->seed ^= c->seed << 17;
+  return c->seed;
+}
+
+static u64 op_pool_churn(void* ctx, u64 i) {
+  churn_ctx* c = ctx;
+  const u64 slot = churn_rand(c) % 4096;
+  (void)i;
+
+  if (c->held[slot] != NULL) {
+    pool_free(c->pool, c->held[slot]);
+    c->held[slot] = NULL;
+    return 0;
+  }
+
+  const u64 s = c->s_min + churn_rand(c) % (c->s_max - c->s_min + 1);
+  c->held[slot] = pool_alloc(c->pool, s);
+
+  return (u64)(uintptr_t)c->held[slot];
+}
+
+static u64 op_malloc_churn(void* ctx, u64 i) {
+  churn_ctx* c = ctx;
+  const u64 slot = churn_rand(c) % 4096;
+  (void)i;
+
+  if (c->held[slot] != NULL) {
+    free(c->held[slot]);
+    c->held[slot] = NULL;
+    return 0;
+  }
+
+  const u64 s = c->s_min + churn_rand(c) % (c->s_max - c->s_min + 1);
+  c->held[slot] = malloc(s);
+
+  return (u64)(uintptr_t)c->held[slot];
+}
+
+static void churn_drain_pool(churn_ctx* c) {
+  for (u64 i = 0; i < 4096; i++)
+    if (c->held[i]) {
+      pool_free(c->pool, c->held[i]);
+      c->held[i] = NULL;
+    }
+}
+
+static void churn_drain_malloc(churn_ctx* c) {
+  for (u64 i = 0; i < 4096; i++)
+    if (c->held[i]) {
+      free(c->held[i]);
+      c->held[i] = NULL;
+    }
+}
+
+// ------------------------------- pool frag ----------------------------------
+
+static u64 op_pool_frag(void* ctx, u64 i) {
+  churn_ctx* c = ctx;
+  const u64 phase = i % 3072;
+
+  if (phase < 2048) {
+    // fill with small blocks
+    if (c->held[phase] == NULL)
+      c->held[phase] = pool_alloc(c->pool, c->s_min);
+    return (u64)(uintptr_t)c->held[phase];
+  }
+
+  if (phase < 2048 + 512) {
+    // punch holes
+    const u64 victim = (phase - 2048) * 2;
+    if (c->held[victim]) {
+      pool_free(c->pool, c->held[victim]);
+      c->held[victim] = NULL;
+    }
+    return 0;
+  }
+
+  // allocate larger runs into the fragmented space
+  void* p = pool_alloc(c->pool, c->s_max);
+  if (p)
+    pool_free(c->pool, p);
+
+  return (u64)(uintptr_t)p;
+}
+
+// -------------------------------- arena mt ----------------------------------
+
+typedef struct { ArenaMT* arena; u64 ops; } mt_ctx;
+
+static void* mt_worker(void* arg) {
+  mt_ctx* c = arg;
+
+  for (u64 i = 0; i < c->ops; i++)
+    arena_alloc_mt(c->arena, 64);
+
+  return NULL;
+}
+
+static void* mt_worker_malloc(void* arg) {
+  mt_ctx* c = arg;
+  void* held[1024] = { 0 };
+
+  for (u64 i = 0; i < c->ops; i++) {
+    const u64 slot = i % 1024;
+    free(held[slot]);
+    held[slot] = malloc(64);
+  }
+
+  for (u64 i = 0; i < 1024; i++)
+    free(held[i]);
+
+  return NULL;
+}
+
+static void bench_mt(const u64 n_threads, const u64 ops_per_thread, const bool use_malloc) {
+  pthread_t threads[64];
+  mt_ctx ctx = {
+    .arena = use_malloc ? NULL : arena_create_mt(MB(64), 64, n_threads),
+    .ops   = ops_per_thread
+  };
+
+  const u64 t0 = bench_now_ns();
+
+  for (u64 i = 0; i < n_threads; i++)
+    pthread_create(&threads[i], NULL, use_malloc ? mt_worker_malloc : mt_worker, &ctx);
+  for (u64 i = 0; i < n_threads; i++)
+    pthread_join(threads[i], NULL);
+
+  const u64 elapsed = bench_now_ns() - t0;
+
+  printf(
+    "%-28s %12.0f ops/s   (%zu threads)\n",
+    use_malloc ? "malloc mt" : "arena mt",
+    elapsed > 0 ? (f64)(n_threads * ops_per_thread) * 1e9 / (f64)elapsed : 0.0,
+    n_threads
+  );
+
+  if (ctx.arena)
+    arena_destroy_mt(ctx.arena);
+}
+
+// ------------------------------ trace replay --------------------------------
+
+// replays "a <id> <size>" / "f <id>" lines against the pool and malloc
+static int bench_trace(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    fprintf(stderr, "bench: cannot open trace '%s'\n", path);
+    return 1;
+  }
+
+  enum { S_LIVE = 1 << 20 };
+  void** live = calloc(S_LIVE, sizeof(void*));
+  u64* sizes  = calloc(S_LIVE, sizeof(u64));
+
+  for (int pass = 0; pass < 2; pass++) {
+    const bool use_malloc = pass == 1;
+    Pool* pool = use_malloc ? NULL : pool_create(MB(256), 64, 16);
+
+    rewind(file);
+
+    char op;
+    u64 id, size, ops = 0;
+    const u64 t0 = bench_now_ns();
+
+    while (fscanf(file, " %c %zu", &op, &id) == 2) {
+      if (id >= S_LIVE)
+        continue;
+
+      if (op == 'a') {
+        if (fscanf(file, "%zu", &size) != 1)
+          break;
+
+        live[id]  = use_malloc ? malloc(size) : pool_alloc(pool, size);
+        sizes[id] = size;
+      } else if (op == 'f' && live[id] != NULL) {
+        if (use_malloc)
+          free(live[id]);
+        else
+          pool_free(pool, live[id]);
+
+        live[id] = NULL;
+      }
+
+      ops++;
+    }
+
+    const u64 elapsed = bench_now_ns() - t0;
+
+    printf(
+      "%-28s %12.0f ops/s   (%zu ops)\n",
+      use_malloc ? "trace malloc" : "trace pool",
+      elapsed > 0 ? (f64)ops * 1e9 / (f64)elapsed : 0.0,
+      ops
+    );
+
+    for (u64 i = 0; i < S_LIVE; i++)
+      if (live[i]) {
+        if (use_malloc)
+          free(live[i]);
+        live[i] = NULL;
+      }
+
+    if (pool)
+      pool_destroy(pool);
+  }
+
+  free(live);
+  free(sizes);
+  fclose(file);
+
+  return 0;
+}
+
+// ---------------------------------- main ------------------------------------
+
+int main(int argc, char** argv) {
+  if (argc == 3 && strcmp(argv[1], "trace") == 0)
+    return bench_trace(argv[2]);
+
+  const u64 ops = argc == 2 ? strtoull(argv[1], NULL, 10) : 2000000;
+
+  printf("-- arena storm (64 B, reset every 4096) --\n");
+  {
+    storm_ctx c = { .arena = arena_create(MB(1), 8), .s_alloc = 64, .batch = 4096 };
+    bench_run("arena storm", op_arena_storm, &c, ops);
+    arena_destroy(c.arena);
+
+    storm_ctx m = { .s_alloc = 64, .batch = 4096 };
+    bench_run("malloc storm", op_malloc_storm, &m, ops);
+  }
+
+  const struct { const char* name; u64 s_min, s_max; } dists[] = {
+    { "pool churn 64 B",     64,   64 },
+    { "pool churn 64-256 B", 64,  256 },
+    { "pool churn 256-4K B", 256, KB(4) },
+  };
+
+  for (u64 d = 0; d < sizeof(dists) / sizeof(dists[0]); d++) {
+    printf("-- %s vs malloc --\n", dists[d].name);
+
+    churn_ctx c = { .pool = pool_create(MB(64), 64, 8), .s_min = dists[d].s_min, .s_max = dists[d].s_max, .seed = 0x9E3779B97F4A7C15ull };
+    bench_run(dists[d].name, op_pool_churn, &c, ops);
+    churn_drain_pool(&c);
+    pool_destroy(c.pool);
+
+    churn_ctx m = { .s_min = dists[d].s_min, .s_max = dists[d].s_max, .seed = 0x9E3779B97F4A7C15ull };
+    bench_run("malloc churn", op_malloc_churn, &m, ops);
+    churn_drain_malloc(&m);
+  }
+
+  printf("-- fragmentation interleave --\n");
+  {
+    churn_ctx c = { .pool = pool_create(MB(64), 64, 8), .s_min = 64, .s_max = KB(16), .seed = 1 };
+    bench_run("pool frag", op_pool_frag, &c, ops);
+    churn_drain_pool(&c);
+    pool_destroy(c.pool);
+  }
+
+  printf("-- multi-threaded --\n");
+  bench_mt(4, ops / 4, false);
+  bench_mt(4, ops / 4, true);
+
+  return 0;
+}
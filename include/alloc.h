@@ -8,6 +8,10 @@
 
 #include "utils.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @file alloc.h
  * @brief Memory Allocation Interface (Arena & Pool)
@@ -18,10 +22,12 @@
  * - Time Complexity: O(1) for alloc, O(1) for reset.
  * - Space Complexity: O(N) where N is the total requested size (plus 8-byte headers).
  *
- * * 2. Pool (Best-Fit Block Allocator):
- * - What: Segregated storage that divides memory into fixed-size blocks.
+ * * 2. Pool (Segregated-Fit Block Allocator):
+ * - What: Segregated storage that divides memory into fixed-size blocks. Free
+ * regions are kept in power-of-two size bins with a bitmap of non-empty bins.
  * - When: Use for long-lived objects of varying sizes where you need to free and reuse memory.
- * - Time Complexity: O(F) for alloc/free (F = free list length). O(1) for reset.
+ * - Time Complexity: O(1) find-fit for alloc (bounded bin scan + ctz); free still
+ * scans for physical neighbors to coalesce. O(1) for reset.
  * - Space Complexity: O(N) with metadata overhead stored in an internal Arena.
  */
 
@@ -31,17 +37,154 @@
 
 typedef struct arena Arena;
 
+/**
+ * Checkpoint of an arena's allocation cursor. Obtained from arena_save and
+ * handed back to arena_restore to roll back every allocation made in between.
+ * Marks are invalidated by arena_reset/arena_destroy and by restoring to an
+ * older mark.
+ */
+typedef struct arena_mark {
+  Arena* node;
+  void*  ptr;
+} ArenaMark;
+
 Arena* arena_create             (const u64 s_arena, const u64 max_nodes);
 
+/**
+ * Reserves a single contiguous virtual range of s_reserve bytes (PROT_NONE)
+ * and commits pages on demand as the bump pointer advances, starting with
+ * s_commit bytes. The arena never chains extra nodes: growth is an mprotect
+ * of already-reserved address space, pointer-range checks stay O(1), and
+ * arena_reset returns the touched pages with madvise(MADV_DONTNEED).
+ */
+Arena* arena_create_reserve     (const u64 s_reserve, const u64 s_commit);
+
+/**
+ * Like arena_create but the node memory is mmap'd with MAP_HUGETLB, falling
+ * back to a normal mapping advised MADV_HUGEPAGE when no huge pages are
+ * reserved. Large arenas stop thrashing the dTLB during allocation storms.
+ * Chain growth keeps the same backing.
+ */
+Arena* arena_create_huge        (const u64 s_arena, const u64 max_nodes);
+
+/**
+ * Like arena_create but every chain node's memory is bound to the given NUMA
+ * node with mbind(MPOL_BIND), so workers pinned to that socket always touch
+ * local memory. Fails if the kernel rejects the binding.
+ */
+Arena* arena_create_numa        (const u64 s_arena, const u64 max_nodes, const i32 numa_node);
+
+/**
+ * Arena backed by the POSIX shared-memory object `name` (created on first
+ * use), for zero-copy handoff between processes: a producer builds a
+ * structure in the arena and a consumer mapping the same name reads it in
+ * place. The arena never chains, so arena_offset_of/arena_ptr_at handles
+ * stay valid across address spaces. arena_destroy unmaps but does not
+ * unlink; remove the object with shm_unlink(3) when every side is done.
+ */
+Arena* arena_create_shm         (const char* name, const u64 s_arena);
+
+/**
+ * Fixed-budget FIFO arena for streaming stages: arena_alloc bumps forward
+ * and wraps to the start of the buffer when the end is reached, so the stage
+ * runs in constant memory with no reset pauses. The caller retires old
+ * entries by advancing the release cursor: arena_ring_release_until frees
+ * every allocation strictly older than ptr (NULL retires everything); a
+ * pointer that is not a live entry releases nothing and returns false.
+ * Allocation fails once the live window would catch the cursor. The ring
+ * never chains, rounds sizes up to 8 bytes and ignores the default
+ * alignment.
+ */
+Arena* arena_create_ring        (const u64 s_arena);
+bool   arena_ring_release_until (Arena* arena, const void* ptr);
+
+// position-independent handles: an offset from the head node's base usable
+// in any process that mapped the same memory. arena_offset_of returns
+// (u64)-1 for pointers the arena does not own or that live in a chained
+// node (only head-node offsets round-trip); arena_ptr_at rejects offsets
+// past the head node
+u64    arena_offset_of          (Arena* arena, const void* ptr);
+void*  arena_ptr_at             (Arena* arena, const u64 offset);
+
+/**
+ * Snapshots the whole chain (node sizes and used extents, then each node's
+ * memory at a page-aligned offset) into the file behind fd, which must be
+ * empty and opened O_RDWR. Capacity beyond the used extent is seeked over,
+ * so the image stays sparse on disk.
+ *
+ * arena_deserialize rebuilds the chain by mmap'ing each node's payload
+ * MAP_PRIVATE straight from the file: no bytes are read up front and
+ * untouched pages are shared with the page cache, so a service restoring a
+ * large read-mostly arena starts nearly instantly. Writes after restore go
+ * to copy-on-write pages and never reach the file.
+ */
+bool   arena_serialize          (Arena* arena, const int fd);
+Arena* arena_deserialize        (const int fd);
+
 void*  arena_alloc              (Arena* arena, const u64 s_alloc);
+void*  arena_alloc_aligned      (Arena* arena, const u64 s_alloc, const u64 align);
 void*  arena_alloc_array        (Arena* arena, const u64 s_obj, const u32 count);
 void*  arena_realloc            (Arena* arena, void* ptr, const u64 s_realloc);
 
+// carves count objects of s_obj bytes in one pass, amortizing the node search
+// and commit check across the burst; fills out[0..ret) and returns how many
+// were allocated (may be short if the chain cannot grow any further)
+u64    arena_alloc_batch        (Arena* arena, const u64 s_obj, const u64 count, void** out);
+
+// default alignment (power of two) applied by every subsequent arena_alloc;
+// pass 64 at startup to get cache-line/SIMD-friendly pointers throughout
+bool   arena_set_align          (Arena* arena, const u64 align);
+
 char*  arena_strdup             (Arena* arena, char* str);
 
+/**
+ * printf straight into the arena: the string is formatted once, directly
+ * into the free tail of the cursor node, and the cursor is bumped only over
+ * the bytes actually written — no measuring pass and no staging buffer.
+ * Falls back to measure-then-allocate when the tail is too small or a
+ * default alignment is set. Returns the NUL-terminated string, or NULL when
+ * the chain cannot hold it.
+ */
+char*  arena_sprintf            (Arena* arena, const char* fmt, ...);
+
+/**
+ * Growable string assembled in place in the arena. The buffer stays the
+ * arena's most recent allocation while the builder is live, so growth rides
+ * the arena_realloc tail-extension path and almost never copies;
+ * interleaving other allocations from the same arena forces one copy on the
+ * next growth but remains correct. arena_sb_finish trims the slack back off
+ * the cursor and returns the string; the builder is spent afterwards.
+ */
+typedef struct arena_string_builder {
+  Arena* arena;
+  char* str;
+  u64 len, cap;
+} ArenaStringBuilder;
+
+ArenaStringBuilder arena_sb_create (Arena* arena);
+
+bool   arena_sb_append          (ArenaStringBuilder* sb, const char* str);
+bool   arena_sb_append_char     (ArenaStringBuilder* sb, const char c);
+bool   arena_sb_appendf         (ArenaStringBuilder* sb, const char* fmt, ...);
+char*  arena_sb_finish          (ArenaStringBuilder* sb);
+
 void   arena_print              (Arena* arena, FILE* file);
 
+ArenaMark arena_save            (Arena* arena);
+bool   arena_restore            (Arena* arena, const ArenaMark mark);
+
 bool   arena_reset              (Arena* arena);
+bool   arena_reset_fast         (Arena* arena);
+
+/**
+ * Releases memory the chain no longer needs: fully-empty non-head nodes are
+ * unlinked and freed, and a reserve-backed arena decommits the pages past
+ * its bump cursor. Returns the number of nodes released. Safe to call from
+ * a background maintenance thread between allocation phases (not
+ * concurrently with allocation).
+ */
+u64    arena_trim               (Arena* arena);
+
 bool   arena_destroy            (Arena* arena);
 
 u64    arena_get_size           (Arena* arena);
@@ -49,25 +192,281 @@ u64    arena_get_size_nodes_max (Arena* arena);
 u64    arena_get_size_nodes     (Arena* arena);
 u64    arena_get_size_used      (Arena* arena);
 
+/**
+ * Snapshot of counters maintained on the alloc/free paths. Filling the struct
+ * walks only the (short) node chain — never a free list — so it is cheap
+ * enough to poll at high frequency from a monitoring thread.
+ */
+typedef struct arena_stats {
+  u64
+    s_total,  // bytes reserved across all nodes
+    s_used,   // bytes currently allocated (headers included)
+    s_peak,   // high-water mark of s_used
+    n_allocs, // cumulative successful allocations
+    s_nodes;  // nodes in the chain
+} ArenaStats;
+
+ArenaStats arena_get_stats      (Arena* arena);
+
+/**
+ * * 3. ArenaMT (Thread-Sharded Arena):
+ * - What: N independent arena shards; each thread bumps its own shard, new chain
+ * nodes are attached with CAS. No external locking required.
+ * - When: Use when many threads allocate concurrently with a shared lifetime.
+ * - Time Complexity: O(1) for alloc on the fast path (one CAS on the shard cursor).
+ */
+
+typedef struct arena_mt ArenaMT;
+
+ArenaMT* arena_create_mt        (const u64 s_arena, const u64 max_nodes, const u64 n_shards);
+
+void*  arena_alloc_mt           (ArenaMT* arena, const u64 s_alloc);
+
+void   arena_print_mt           (ArenaMT* arena, FILE* file);
+
+bool   arena_reset_mt           (ArenaMT* arena);
+bool   arena_destroy_mt         (ArenaMT* arena);
+
+u64    arena_get_size_shards    (ArenaMT* arena);
+u64    arena_get_size_used_mt   (ArenaMT* arena);
+
 typedef struct pool Pool;
 
 Pool*  pool_create              (const u64 s_arena, const u64 s_block, const u64 max_nodes);
 
+/**
+ * Pool whose occupancy is tracked by a bitmap (one bit per block) instead of
+ * the linked free-region list. Find-fit is a branch-light scan over 64-bit
+ * words with ctz — whole-word fast paths cover 64 blocks per compare — and
+ * free is a bit clear, so neither degrades as fragmentation grows. A pool of
+ * a million blocks needs a 128 KB bitmap, which sits comfortably in L2.
+ */
+Pool*  pool_create_bitmap       (const u64 s_pool, const u64 s_block, const u64 max_nodes);
+
 void*  pool_alloc               (Pool* pool, const u64 s_alloc);
+
+/**
+ * Like pool_alloc but the returned pointer is aligned to align (a power of
+ * two). Alignments above 8 are served by over-allocating one stride of slack
+ * and handing the unused blocks back. Exception: in a pool of 8-byte blocks
+ * every user address is congruent to 8 mod 16, so align > 8 is geometrically
+ * unsatisfiable and is rejected with NULL; use a block size of 16 or more
+ * when larger alignments are needed.
+ */
+void*  pool_alloc_aligned       (Pool* pool, const u64 s_alloc, const u64 align);
+
+// like pool_alloc_aligned with the block count supplied by the caller; the
+// backing entry point for pool_alloc_sized (returns NULL on a wrong count)
+void*  pool_alloc_blocks        (Pool* pool, const u64 s_alloc, const u64 blocks, const u64 align);
+
+// block count for an allocation of s bytes in a pool of s_block-byte blocks;
+// folds to a constant when both arguments are literals
+#define POOL_BLOCKS(s, s_block) (((u64)(s) + (u64)(s_block) - 1) / (u64)(s_block))
+
+/**
+ * Specialized entry point for fixed-size hot paths: with literal s and
+ * s_block the block count resolves at compile time, so the call skips the
+ * bytes-to-blocks conversion entirely and jumps straight to the bin search.
+ * s_block must match the pool's actual block size — pool_create rounds the
+ * requested size up to a power of two, so pass the rounded value; a
+ * mismatched count returns NULL. A default alignment set with
+ * pool_set_align is honored, same as pool_alloc.
+ *
+ *   obj = pool_alloc_sized(pool, 160, 64); // 3 blocks, folded at build time
+ */
+#define pool_alloc_sized(pool, s, s_block) \
+  pool_alloc_blocks((pool), (s), POOL_BLOCKS((s), (s_block)), pool_get_align(pool))
 void*  pool_alloc_array         (Pool* pool, const u64 s_obj, const u32 count);
 void*  pool_realloc             (Pool* pool, void* ptr, const u64 s_realloc);
 
+// carves count objects of s_obj bytes from one free region found with a single
+// search; each object remains individually freeable. Falls back to per-object
+// allocation when no region can hold the whole burst. Fills out[0..ret) and
+// returns how many were allocated
+u64    pool_alloc_batch         (Pool* pool, const u64 s_obj, const u64 count, void** out);
+
+// frees count pointers at once: sorts ptrs in place by address and hands each
+// run of physically adjacent objects to the coalescer as one region
+bool   pool_free_batch          (Pool* pool, void** ptrs, const u64 count);
+
+// default alignment (power of two) applied by pool_alloc and pool_alloc_sized
+bool   pool_set_align           (Pool* pool, const u64 align);
+u64    pool_get_align           (Pool* pool);
+
 char*  pool_strdup              (Pool* pool, char* str);
 
 void   pool_print               (Pool* pool, FILE* file);
 
 bool   pool_free                (Pool* pool, void* ptr);
+void   pool_set_wipe            (Pool* pool, const bool wipe);
+
+/**
+ * Deferred coalescing: with a nonzero threshold, pool_free pushes the blocks
+ * onto a cheap pending stack instead of running the adjacency merge — ideal
+ * for churn phases where a freed block is usually re-allocated immediately.
+ * Pending frees are folded back in when the stack reaches `threshold`
+ * entries, when an allocation misses on a node, or on pool_flush (call it at
+ * epoch boundaries). Until then the stats still count them as used. A
+ * threshold of 0 restores immediate mode (the default) and flushes.
+ */
+void   pool_set_defer           (Pool* pool, const u64 threshold);
+bool   pool_flush               (Pool* pool);
+
+/**
+ * Size-aware node routing for mixed-size workloads on chained pools.
+ * Allocations of up to s_small bytes are steered to the chain node with the
+ * tightest free run that still fits, so small objects stop nibbling the
+ * large contiguous runs later nodes hold for big requests; larger
+ * allocations keep the ordered first-fit walk. Each node also caches an
+ * upper bound on its largest free run, so nodes that cannot satisfy a
+ * request are skipped in O(1) instead of paying a failed search. 0 (the
+ * default) disables the steering; the run cache is always maintained.
+ */
+bool   pool_set_route           (Pool* pool, const u64 s_small);
+
+// invoked once per live allocation that pool_compact moves, so the caller
+// can fix up references; the payload has already been copied when it fires
+typedef void (*PoolRelocateFn)(void* ctx, void* old_ptr, void* new_ptr, const u64 size);
+
+/**
+ * Slides every live allocation toward the base of its node, leaving one
+ * maximal free region at the tail — a 7-day-old pool allocates like a fresh
+ * one afterwards. Each node is compacted independently; pending deferred
+ * frees are flushed first. Opt-in and O(bytes moved): run it during idle
+ * windows. relocate may be NULL when nothing holds pointers into the pool.
+ *
+ * Blocks cached in a PoolMagazine still look live to the pool, so they get
+ * relocated and the magazine's cached pointers dangle: pool_magazine_flush
+ * every magazine back into the pool before compacting.
+ */
+bool   pool_compact             (Pool* pool, PoolRelocateFn relocate, void* ctx);
 bool   pool_reset               (Pool* pool);
+
+// unlinks and frees every non-head node with no live blocks (pending frees
+// are flushed first); returns the number of nodes released
+u64    pool_trim                (Pool* pool);
+
 bool   pool_destroy             (Pool* pool);
 
+/**
+ * * 4. FixedPool (Headerless Fixed-Size Pool):
+ * - What: A typed pool for objects of one size. Free slots form an intrusive
+ * list threaded through the slots themselves: zero per-object metadata, and
+ * payloads are packed contiguously so linear traversals stay cache-resident.
+ * - When: Use for many small objects of one type (nodes, particles, handles).
+ * - Time Complexity: O(1) for alloc and free (a list push/pop or cursor bump).
+ * - Space Complexity: exactly s_obj * count per node, no headers.
+ */
+
+typedef struct fixed_pool FixedPool;
+
+FixedPool* pool_create_fixed    (const u64 s_obj, const u64 count, const u64 max_nodes);
+
+void*  pool_fixed_alloc         (FixedPool* pool);
+bool   pool_fixed_free          (FixedPool* pool, void* ptr);
+
+void   pool_fixed_print         (FixedPool* pool, FILE* file);
+
+bool   pool_fixed_reset         (FixedPool* pool);
+bool   pool_fixed_destroy       (FixedPool* pool);
+
+u64    pool_fixed_get_size      (FixedPool* pool);
+u64    pool_fixed_get_size_used (FixedPool* pool);
+
+/**
+ * * 5. PoolMagazine (Per-Thread Cache):
+ * - What: A small per-thread cache of recently freed blocks, bucketed by block
+ * count, sitting in front of a shared Pool. Hits never touch the free list;
+ * misses refill/flush in batches.
+ * - When: Give one magazine to each thread that churns small objects. The
+ * shared Pool itself is not synchronized: guard the refill/flush fallback
+ * with the same lock you already use around pool_alloc/pool_free.
+ * - Time Complexity: O(1) for cached alloc/free (a stack push/pop).
+ */
+
+typedef struct pool_magazine PoolMagazine;
+
+PoolMagazine* pool_magazine_create (Pool* pool);
+
+void*  pool_magazine_alloc      (PoolMagazine* mag, const u64 s_alloc);
+bool   pool_magazine_free       (PoolMagazine* mag, void* ptr);
+
+bool   pool_magazine_flush      (PoolMagazine* mag);
+bool   pool_magazine_destroy    (PoolMagazine* mag);
+
 u64    pool_get_size            (Pool* pool);
 u64    pool_get_size_nodes_max  (Pool* pool);
 u64    pool_get_size_nodes      (Pool* pool);
 u64    pool_get_size_used       (Pool* pool);
 
+typedef struct pool_stats {
+  u64
+    s_total,          // bytes of block storage across all nodes
+    s_used,           // bytes of blocks currently allocated
+    s_peak,           // high-water mark of s_used
+    n_allocs,         // cumulative successful allocations
+    n_frees,          // cumulative successful frees
+    n_free_regions,   // current free-list length across all nodes
+    s_largest_region, // largest contiguous free run, in bytes
+    s_nodes;          // nodes in the chain
+} PoolStats;
+
+PoolStats pool_get_stats        (Pool* pool);
+
+/**
+ * * 6. Instrumentation (compile-time optional):
+ * - What: Event hooks plus lock-free latency/size/search-length histograms
+ * over the hot paths, for attributing production p99 spikes to fragmentation
+ * growth instead of guessing.
+ * - When: Build with -DALLOC_TRACE (make TRACE=1). Without the flag every
+ * probe compiles to nothing — no branches, no loads — so release binaries
+ * pay zero cost.
+ *
+ * * 7. Validation modes (compile-time optional):
+ * - ALLOC_DEBUG (make DEBUG=1): every size header carries a canary byte,
+ * freed blocks are poisoned, and a stray pointer, smashed header or double
+ * free aborts with a report naming the pointer — for staging builds.
+ * - ALLOC_RELEASE (make RELEASE=1): pool_free/pool_realloc/arena_realloc
+ * trust the caller and skip pointer pre-validation entirely — for
+ * production, where the wrapper checks live at the call sites that need
+ * them. The default build validates and fails soft (returns false/NULL).
+ */
+
+#ifdef ALLOC_TRACE
+
+typedef enum alloc_event {
+  ALLOC_EVENT_ARENA_ALLOC = 0, // size = bytes requested, ns = call latency
+  ALLOC_EVENT_ARENA_GROW  = 1, // size = new node's capacity
+  ALLOC_EVENT_POOL_ALLOC  = 2, // size = bytes requested, ns = call latency
+  ALLOC_EVENT_POOL_FREE   = 3, // size = bytes returned,  ns = call latency
+  ALLOC_EVENT_POOL_GROW   = 4, // size = new node's capacity
+  ALLOC_EVENT_POOL_SEARCH = 5  // size = free regions inspected by one find
+} AllocEvent;
+
+typedef void (*AllocHook)(void* ctx, const AllocEvent event, const u64 size, const u64 ns);
+
+// one process-wide hook, swapped atomically; NULL disables callbacks while
+// the histograms keep counting
+void alloc_set_hook             (AllocHook hook, void* ctx);
+
+/**
+ * Power-of-two-bucketed counters (bucket b counts values in [2^b, 2^(b+1))),
+ * maintained with relaxed atomic adds so concurrent allocators never
+ * serialize on them. Sample with alloc_get_histogram from any thread.
+ */
+typedef struct alloc_histogram {
+  u64 latency[64]; // ns per arena_alloc/pool_alloc/pool_free call
+  u64 size[64];    // bytes per allocation
+  u64 search[64];  // free regions inspected per pool find
+} AllocHistogram;
+
+void alloc_get_histogram        (AllocHistogram* out);
+void alloc_reset_histogram      (void);
+
+#endif // ALLOC_TRACE
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
 #endif // !__ALLOC_H__
@@ -0,0 +1,180 @@
+#ifndef __ALLOC_HPP__
+#define __ALLOC_HPP__
+
+#include "alloc.h"
+
+#include <cstddef>
+#include <new>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define ALLOC_HAS_PMR 1
+#endif
+
+/**
+ * @file alloc.hpp
+ * @brief C++17 Allocator & memory_resource adapters over the C allocators
+ *
+ * * ArenaAllocator<T> / PoolAllocator<T>:
+ * - What: Allocators satisfying the C++ Allocator requirements, so
+ * std::vector, std::unordered_map and std::basic_string can live directly
+ * in an Arena or Pool — no system-heap round trips for container churn.
+ * - When: Use the arena flavor for request/frame-scoped containers whose
+ * destruction collapses into one arena_reset; use the pool flavor when
+ * elements must be freed and reused individually.
+ *
+ * * ArenaMemoryResource / PoolMemoryResource (when <memory_resource> exists):
+ * - What: std::pmr::memory_resource adapters for the std::pmr:: container
+ * aliases, letting one resource be shared across heterogeneous containers.
+ *
+ * The adapters never own the backing allocator: create and destroy it with
+ * the C API as usual.
+ */
+
+template <typename T>
+class ArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) noexcept : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.backing()) {}
+
+  T* allocate(std::size_t count) {
+    void* ptr = arena_alloc_aligned(
+      arena_, static_cast<u64>(count * sizeof(T)), alignof(T)
+    );
+
+    if (ptr == nullptr)
+      throw std::bad_alloc();
+
+    return static_cast<T*>(ptr);
+  }
+
+  void deallocate(T*, std::size_t) noexcept {
+    // arena memory is reclaimed wholesale by arena_reset/arena_destroy
+  }
+
+  Arena* backing() const noexcept { return arena_; }
+
+private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+  return a.backing() == b.backing();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+  return !(a == b);
+}
+
+template <typename T>
+class PoolAllocator {
+public:
+  using value_type = T;
+
+  explicit PoolAllocator(Pool* pool) noexcept : pool_(pool) {}
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.backing()) {}
+
+  T* allocate(std::size_t count) {
+    void* ptr = pool_alloc_aligned(
+      pool_, static_cast<u64>(count * sizeof(T)), alignof(T)
+    );
+
+    if (ptr == nullptr)
+      throw std::bad_alloc();
+
+    return static_cast<T*>(ptr);
+  }
+
+  void deallocate(T* ptr, std::size_t) noexcept {
+    pool_free(pool_, ptr);
+  }
+
+  Pool* backing() const noexcept { return pool_; }
+
+private:
+  Pool* pool_;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept {
+  return a.backing() == b.backing();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept {
+  return !(a == b);
+}
+
+#ifdef ALLOC_HAS_PMR
+
+class ArenaMemoryResource final : public std::pmr::memory_resource {
+public:
+  explicit ArenaMemoryResource(Arena* arena) noexcept : arena_(arena) {}
+
+  Arena* backing() const noexcept { return arena_; }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    void* ptr = arena_alloc_aligned(
+      arena_, static_cast<u64>(bytes), static_cast<u64>(align)
+    );
+
+    if (ptr == nullptr)
+      throw std::bad_alloc();
+
+    return ptr;
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {
+    // reclaimed wholesale by arena_reset/arena_destroy
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    const auto* resource = dynamic_cast<const ArenaMemoryResource*>(&other);
+    return resource != nullptr && resource->arena_ == arena_;
+  }
+
+  Arena* arena_;
+};
+
+class PoolMemoryResource final : public std::pmr::memory_resource {
+public:
+  explicit PoolMemoryResource(Pool* pool) noexcept : pool_(pool) {}
+
+  Pool* backing() const noexcept { return pool_; }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    void* ptr = pool_alloc_aligned(
+      pool_, static_cast<u64>(bytes), static_cast<u64>(align)
+    );
+
+    if (ptr == nullptr)
+      throw std::bad_alloc();
+
+    return ptr;
+  }
+
+  void do_deallocate(void* ptr, std::size_t, std::size_t) override {
+    pool_free(pool_, ptr);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    const auto* resource = dynamic_cast<const PoolMemoryResource*>(&other);
+    return resource != nullptr && resource->pool_ == pool_;
+  }
+
+  Pool* pool_;
+};
+
+#endif // ALLOC_HAS_PMR
+
+#endif // !__ALLOC_HPP__
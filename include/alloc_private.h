@@ -13,8 +13,10 @@
  *
  * * Implementation Strategy:
  * - Arena: Uses a simple pointer-increment logic. Each allocation is preceded by a u64 size header.
- * - Pool: Implemented using a "Best-Fit" strategy. The `free_list` is strictly maintained 
- * in ascending order of size (s_blocks).
+ * - Pool: Free regions are segregated into power-of-two size bins (`bins`), with a
+ * 64-bit `bin_mask` flagging the non-empty ones. Find-fit is a scan of the exact
+ * bin followed by a ctz over the mask to grab the head of the next non-empty
+ * larger bin, so allocation cost no longer grows with the free-list length.
  *
  * - Metadata Management: To avoid system heap fragmentation, the Pool's `FreeRegion` descriptors 
  * are allocated from an internal Arena (`fl_arena`).
@@ -24,33 +26,148 @@
  * fragmentation manager."
  */
 
+/**
+ * Sorted address-range index kept on the chain head. Maps a user pointer to
+ * its owning node with a binary search instead of walking the chain and
+ * range-testing every node. Entries are appended when the chain grows.
+ */
+typedef struct range_entry {
+  const u8* base;
+  const u8* end;
+  void* owner;
+} RangeEntry;
+
+typedef struct range_index {
+  u64 count, cap;
+  RangeEntry* entries; // sorted by base
+} RangeIndex;
+
+// how an arena node's memory is obtained and released
+enum arena_backing {
+  ARENA_BACKING_HEAP    = 0, // calloc/free
+  ARENA_BACKING_RESERVE = 1, // mmap PROT_NONE reservation, committed on demand
+  ARENA_BACKING_MAP     = 2, // mmap with populated pages (huge/NUMA variants)
+  ARENA_BACKING_SHM     = 3, // mmap MAP_SHARED over a POSIX shm object
+  ARENA_BACKING_RING    = 4  // heap memory treated as a circular FIFO; never chains
+};
+
 struct arena {
-  u64 
+  u64
     s_arena,
     s_nodes,
-    max_nodes;
+    max_nodes,
+    hwm,      // high-water mark: most bytes ever used, so reset only clears what was touched
+    s_commit, // bytes committed so far (ARENA_BACKING_RESERVE only)
+    align,    // default alignment for arena_alloc (1 = none)
+    n_allocs; // successful allocations landed in this node (cumulative)
+
+  u8 backing,
+     huge;      // ARENA_BACKING_MAP: huge pages requested
+
+  i32 numa_node; // ARENA_BACKING_MAP: node the memory is bound to, -1 = unbound
 
   void* memory,
       * ptr;
 
+  // ARENA_BACKING_RING only: oldest live byte, and live bytes between the
+  // cursors (size headers and wrap gaps included)
+  void* tail;
+  u64 s_live;
+
   struct arena* next;
+
+  // head only: first node worth trying, so allocation does not re-walk the
+  // chain from the start once early nodes have filled up
+  struct arena* cursor;
+
+  // head only: pointer-to-node ownership index
+  RangeIndex index;
+};
+
+struct arena_mt {
+  u64 n_shards,
+      shard_rr; // round-robin counter for first-touch shard assignment (atomic)
+
+  Arena** shards;
 };
 
 typedef struct free_region FreeRegion;
 
+// bin b holds free regions with floor(log2(s_blocks)) == b
+#define S_POOL_BINS ((u64)64)
+
 struct pool {
-  u64 
+  u64
     s_pool,
     s_block,
     s_nodes,
-    max_nodes;
+    max_nodes,
+    align, // default alignment for pool_alloc (1 = none)
+
+    // O(1) statistics, maintained per node on the alloc/free paths
+    s_blocks_used,
+    s_blocks_peak,
+    n_regions,
+    n_allocs,
+    n_frees;
+
+  bool wipe_free; // zero blocks on free (default); disable to trade safety for speed
+
+  // deferred coalescing: frees park on `pending` until the stack crosses
+  // s_defer, an allocation misses, or pool_flush runs. 0 = immediate mode
+  u64 s_defer,
+      n_pending;
+  FreeRegion* pending;
+
+  // routing: upper bound on this node's largest free run in blocks, lowered
+  // by a failed find and raised as frees coalesce, so the node search skips
+  // nodes that cannot fit in O(1). s_route > 0 steers allocations of up to
+  // that many bytes to the node with the tightest sufficient run
+  u64 s_run_hint,
+      s_route;
 
   Arena* fl_arena;
-  FreeRegion* free_list;
+  FreeRegion* fl_free; // retired descriptors, recycled before fl_arena is tapped
+
+  // bitmap mode: one bit per block (set = used), padded tail bits set; the
+  // FreeRegion machinery is bypassed entirely. NULL in free-list mode
+  u64* bitmap;
+
+  u64 bin_mask;
+  FreeRegion* bins[S_POOL_BINS];
 
   void* memory;
 
   struct pool* next;
+
+  // head only: pointer-to-node ownership index
+  RangeIndex index;
+};
+
+struct fixed_pool {
+  u64
+    s_obj,
+    count,
+    s_init, // slots handed out sequentially before the free list is consulted
+    s_used,
+    s_nodes,
+    max_nodes;
+
+  void* memory;
+  void* free_head; // intrusive list threaded through the free slots
+
+  struct fixed_pool* next;
+};
+
+// number of size classes (1..N blocks) and rounds cached per class
+#define S_MAG_CLASSES ((u64)8)
+#define S_MAG_ROUNDS  ((u64)32)
+
+struct pool_magazine {
+  Pool* pool;
+
+  u64   count [S_MAG_CLASSES];
+  void* rounds[S_MAG_CLASSES][S_MAG_ROUNDS];
 };
 
 struct free_region {
@@ -62,29 +179,70 @@ struct free_region {
 
 #define S_WORD sizeof(u64)
 
+// header sentinel telling the ring release walk to jump back to the base
+#define ARENA_RING_WRAP ((u64)-1)
+
 // Arena
 
+Arena*                  __arena_create_map          (const u64 s_arena, const u64 max_nodes, const bool huge, const i32 numa_node);
+
 bool                    __arena_is_full             (Arena* arena, const u64 s_alloc);
+bool                    __arena_commit              (Arena* arena, const u64 needed);
 bool                    __arena_valid_alloc         (Arena** arena, const void* ptr);
 bool                    __arena_ptr_in_arena        (const Arena* arena, const void* ptr);
 
 static inline u64       __arena_size_memory         (const Arena* arena);
 
+void*                   __arena_ring_alloc          (Arena* arena, const u64 s_alloc);
+
+bool                    __arena_sb_reserve          (ArenaStringBuilder* sb, const u64 need);
+
 u64                     __arena_get_index           (Arena* arena, const void *ptr);
 static inline void*     __arena_get_base_ptr        (const Arena* arena);
 
+// ArenaMT
+
+u64                     __arena_mt_shard_id         (ArenaMT* arena);
+void*                   __arena_node_alloc_cas      (Arena* node, const u64 s_alloc);
+
 // Pool
 
 bool                    __pool_valid_alloc          (Pool** pool, const void* ptr);
 bool                    __pool_ptr_in_pool          (const Pool* pool, const void* ptr);
 
+void*                   __pool_realloc_in_place     (Pool* pool, void* ptr, const u64 s_realloc);
+
 bool                    __pool_free_region_find     (Pool* pool, const u64 blocks, u64* index);
+bool                    __pool_free_region_find_aligned (Pool* pool, const u64 blocks, const u64 align, u64* index);
 void                    __pool_free_region_append   (Pool* pool, const u64 s_blocks, const u64 start_block);
+
+FreeRegion*             __pool_region_acquire       (Pool* pool);
+void                    __pool_region_release       (Pool* pool, FreeRegion* region);
+
+static inline u64       __pool_bitmap_words         (const Pool* pool);
+void                    __pool_bitmap_pad           (Pool* pool);
+void                    __pool_bitmap_set           (Pool* pool, u64 index, u64 blocks, const bool used);
+bool                    __pool_bitmap_test          (const Pool* pool, u64 index, u64 blocks);
+bool                    __pool_bitmap_find          (Pool* pool, const u64 blocks, u64* index);
+void                    __pool_bitmap_stats         (const Pool* pool, u64* n_regions, u64* s_largest);
+
+void                    __pool_pending_flush        (Pool* pool);
 bool                    __pool_free_region_update   (Pool* pool, const u64 index, const u64 blocks);
 
+bool                    __pool_fixed_ptr_in_pool    (const FixedPool* pool, const void* ptr);
+
+bool                    __pool_magazine_refill      (PoolMagazine* mag, const u64 class);
+void                    __pool_magazine_drain       (PoolMagazine* mag, const u64 class, const u64 keep);
+
 static inline u64       __pool_region_end           (const FreeRegion* region);
-void                    __pool_unlink_region        (Pool* pool, FreeRegion* regiona);
-void                    __pool_insert_region_sorted (Pool* pool, FreeRegion* region);
+static inline u64       __pool_bin_index            (const u64 s_blocks);
+void                    __pool_unlink_region        (Pool* pool, FreeRegion* region);
+void                    __pool_bin_insert           (Pool* pool, FreeRegion* region);
+
+static inline void*     __pool_block_ptr            (const Pool* pool, const u64 block);
+void                    __pool_region_tag_write     (Pool* pool, const FreeRegion* region);
+void                    __pool_region_tag_clear     (Pool* pool, const FreeRegion* region);
+FreeRegion*             __pool_region_tag_read      (const Pool* pool, void* tag_addr);
 
 static inline u64       __pool_size_memory          (const Pool* pool);
 static inline u64       __pool_bytes_to_block       (const Pool* pool, const u64 bytes);
@@ -92,6 +250,57 @@ static inline u64       __pool_bytes_to_block       (const Pool* pool, const u64
 u64                     __pool_get_index            (const Pool* pool, const void *ptr);
 static inline void*     __pool_get_base_ptr         (const Pool* pool);
 
+// Range Index
+
+bool                    __range_index_insert        (RangeIndex* index, const void* base, const void* end, void* owner);
+void                    __range_index_remove        (RangeIndex* index, const void* base);
+void*                   __range_index_find          (const RangeIndex* index, const void* ptr);
+void                    __range_index_dispose       (RangeIndex* index);
+
+// Trace (compiled out unless ALLOC_TRACE is defined)
+
+#ifdef ALLOC_TRACE
+u64                     __alloc_trace_now           (void);
+void                    __alloc_trace_event         (const AllocEvent event, const u64 size, const u64 ns);
+
+#define ALLOC_TRACE_ENTER()           const u64 __trace_t0 = __alloc_trace_now()
+#define ALLOC_TRACE_EMIT(event, size) __alloc_trace_event((event), (size), __alloc_trace_now() - __trace_t0)
+#define ALLOC_TRACE_COUNT(event, n)   __alloc_trace_event((event), (n), 0)
+#else
+#define ALLOC_TRACE_ENTER()           ((void)0)
+#define ALLOC_TRACE_EMIT(event, size) ((void)0)
+#define ALLOC_TRACE_COUNT(event, n)   ((void)0)
+#endif
+
+// Debug (header canaries, poison-on-free, double-free detection)
+
+#if defined(ALLOC_DEBUG) && defined(ALLOC_RELEASE)
+#error "ALLOC_DEBUG and ALLOC_RELEASE are mutually exclusive"
+#endif
+
+#ifdef ALLOC_DEBUG
+/*
+ * The top byte of every size header carries a canary; pool_free swaps it for
+ * a freed sentinel. __alloc_debug_size verifies the byte on every header
+ * read, so a stray pointer, a smashed header and a double free each abort
+ * with a distinct report instead of corrupting the allocator.
+ */
+#define ALLOC_DEBUG_MASK   ((u64)0xFF << 56)
+#define ALLOC_DEBUG_CANARY ((u64)0xA5 << 56)
+#define ALLOC_DEBUG_FREED  ((u64)0xDF << 56)
+#define ALLOC_DEBUG_POISON 0xDD
+
+u64                     __alloc_debug_size          (const u64 header, const void* ptr);
+
+#define ALLOC_HEADER(s)         ((s) | ALLOC_DEBUG_CANARY)
+#define ALLOC_HEADER_FREED      ALLOC_DEBUG_FREED
+#define ALLOC_SIZE(header, ptr) __alloc_debug_size((header), (ptr))
+#else
+#define ALLOC_HEADER(s)         (s)
+#define ALLOC_HEADER_FREED      ((u64)0)
+#define ALLOC_SIZE(header, ptr) (header)
+#endif
+
 // Alloc Utils
 
 static inline void*     __alloc_utils_ptr_incr      (const void* ptr, const u64 bytes);
@@ -99,6 +308,10 @@ static inline void*     __alloc_utils_ptr_decr      (const void* ptr, const u64
 static inline ptrdiff_t __alloc_utils_ptr_diff      (const void* ptr1, const void* ptr2);
 
 u64                     __alloc_utils_next_power_2  (u64 s);
+static inline u64       __alloc_utils_ctz           (const u64 s);
+static inline u64       __alloc_utils_page_align    (const u64 bytes);
+static inline bool      __alloc_utils_is_power_2    (const u64 s);
+static inline u64       __alloc_utils_align_up      (const u64 s, const u64 align);
 static inline u64       __alloc_utils_ceil          (const f64 x);
 
 static inline u64       __alloc_utils_max           (const u64 a, const u64 b);
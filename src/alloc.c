@@ -1,19 +1,36 @@
 #include "alloc_private.h"
 
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdarg.h>
+
+#ifdef ALLOC_TRACE
+#include <time.h>
+#endif
+
+// mbind is issued through syscall(2) to avoid a libnuma dependency
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+
 /**
  * CRITICAL IMPLEMENTATION NOTES:
  *
  * * __pool_free_region_find:
- * Implements Best-Fit. Since the list is sorted ASCENDING, the first region found 
- * that satisfies 'blocks' is the smallest possible fit. After splitting, the 
- * remaining fragment is shrunk and "bubbled up" toward the head of the list 
- * using a swap-based sort to maintain the ascending invariant.
+ * Implements segregated-fit. Free regions live in power-of-two size bins with a
+ * bitmask of non-empty bins. The exact bin (floor(log2(blocks))) is scanned for
+ * the tightest fit; if it holds none, a ctz over the masked-off larger bins
+ * yields a bin whose head is guaranteed to satisfy the request. After splitting,
+ * the remainder is simply re-binned by its new size — no sorting pass needed.
  *
  * * __pool_free_region_update:
- * Handles deallocation. It ignores the list order to perform a linear scan 
- * for physical adjacency (left/right neighbors). This allows us to merge 
+ * Handles deallocation. It walks the occupied bins to perform a linear scan
+ * for physical adjacency (left/right neighbors). This allows us to merge
  * contiguous free blocks back into larger ones, fighting external fragmentation.
- * Once merged, the region is re-inserted into the list based on its new size.
+ * Once merged, the region is re-inserted into the bin matching its new size.
  */
 
 // ====================================# PUBLIC #======================================
@@ -37,373 +54,2065 @@ Arena* arena_create(const u64 s_arena, const u64 max_nodes) {
   }
 
   arena->ptr       = __arena_get_base_ptr(arena);
+  arena->hwm       = 0;
+  arena->s_commit  = 0;
+  arena->tail      = NULL;
+  arena->s_live    = 0;
+  arena->align     = 1;
+  arena->n_allocs  = 0;
+  arena->backing   = ARENA_BACKING_HEAP;
+  arena->huge      = 0;
+  arena->numa_node = -1;
   arena->max_nodes = max_nodes;
   arena->s_nodes   = 1;
   arena->next      = NULL;
+  arena->cursor    = arena;
+
+  arena->index = (RangeIndex){ 0 };
+  if (!__range_index_insert(
+    &arena->index,
+    arena->memory, __alloc_utils_ptr_incr(arena->memory, arena->s_arena),
+    arena
+  )) {
+    free(arena->memory);
+    free(arena);
+    return NULL;
+  }
 
   return arena;
 }
 
-void* arena_alloc(Arena* arena, const u64 s_alloc) {
-  if (arena == NULL || s_alloc == 0 || s_alloc > arena->s_arena)
+Arena* arena_create_reserve(const u64 s_reserve, const u64 s_commit) {
+  if (s_reserve == 0 || s_commit > s_reserve)
     return NULL;
 
-  Arena* node = arena;
-  for (
-    ;
-    node->next != NULL && __arena_is_full(node, s_alloc);
-    node = node->next
-  );
-
-  if (node->next == NULL && __arena_is_full(node, s_alloc)) {
-    if (arena->s_nodes >= arena->max_nodes)
-      return NULL;
-
-    node->next = arena_create(arena->s_arena, arena->max_nodes);
-
-    if (node->next == NULL)
-      return NULL;
+  Arena* arena = (Arena*)malloc(sizeof(struct arena));
+  if (arena == NULL)
+    return NULL;
 
-    arena->s_nodes++;
+  arena->s_arena = __alloc_utils_page_align(s_reserve);
 
-    return arena_alloc(node->next, s_alloc);
+  arena->memory = mmap(
+    NULL, arena->s_arena,
+    PROT_NONE,
+    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+    -1, 0
+  );
+  if (arena->memory == MAP_FAILED) {
+    free(arena);
+    return NULL;
   }
-   
-  u64* s_ptr = (u64*)node->ptr;
-  void* ptr = __alloc_utils_ptr_incr(node->ptr, S_WORD);
 
-  *s_ptr = s_alloc;
+  arena->ptr       = __arena_get_base_ptr(arena);
+  arena->hwm       = 0;
+  arena->s_commit  = 0;
+  arena->tail      = NULL;
+  arena->s_live    = 0;
+  arena->align     = 1;
+  arena->n_allocs  = 0;
+  arena->backing   = ARENA_BACKING_RESERVE;
+  arena->huge      = 0;
+  arena->numa_node = -1;
+  arena->max_nodes = 1; // the reservation is the growth headroom: never chain
+  arena->s_nodes   = 1;
+  arena->next      = NULL;
+  arena->cursor    = arena;
+
+  arena->index = (RangeIndex){ 0 };
+  if (!__range_index_insert(
+    &arena->index,
+    arena->memory, __alloc_utils_ptr_incr(arena->memory, arena->s_arena),
+    arena
+  )) {
+    munmap(arena->memory, arena->s_arena);
+    free(arena);
+    return NULL;
+  }
 
-  node->ptr = __alloc_utils_ptr_incr(ptr, s_alloc);
+  if (s_commit > 0 && !__arena_commit(arena, s_commit)) {
+    munmap(arena->memory, arena->s_arena);
+    __range_index_dispose(&arena->index);
+    free(arena);
+    return NULL;
+  }
 
-  return ptr;
+  return arena;
 }
 
-void* arena_alloc_array(Arena* arena, const u64 s_obj, const u32 count) {
-  return arena_alloc(arena, (u64)count * s_obj);
+Arena* arena_create_huge(const u64 s_arena, const u64 max_nodes) {
+  return __arena_create_map(s_arena, max_nodes, true, -1);
 }
 
-void* arena_realloc(Arena* arena, void* ptr, const u64 s_realloc) {
-  if (arena == NULL)
+Arena* arena_create_numa(const u64 s_arena, const u64 max_nodes, const i32 numa_node) {
+  if (numa_node < 0 || numa_node >= 64)
     return NULL;
 
-  if (ptr == NULL)
-    return arena_alloc(arena, s_realloc);
+  return __arena_create_map(s_arena, max_nodes, false, numa_node);
+}
 
-  if (!__arena_ptr_in_arena(arena, ptr))
+Arena* arena_create_shm(const char* name, const u64 s_arena) {
+  if (name == NULL || s_arena == 0)
     return NULL;
 
-  void* new_ptr = arena_alloc(arena, s_realloc);
-  if (new_ptr == NULL)
+  Arena* arena = (Arena*)malloc(sizeof(struct arena));
+  if (arena == NULL)
     return NULL;
 
-  u64 old_size = *(u64*)__alloc_utils_ptr_decr(ptr, S_WORD);
-
-  memcpy(new_ptr, ptr, __alloc_utils_min(old_size, s_realloc));
-
-  return new_ptr;
-}
+  arena->s_arena = __alloc_utils_page_align(__alloc_utils_next_power_2(s_arena));
 
-char* arena_strdup(Arena* arena, char* str) {
-  if (str == NULL)
+  const int fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+  if (fd < 0) {
+    free(arena);
     return NULL;
+  }
 
-  u64 len = strlen(str) + 1;
-  char* copy = (char*)arena_alloc(arena, len);
-  if (copy == NULL)
+  if (ftruncate(fd, (off_t)arena->s_arena) != 0) {
+    close(fd);
+    free(arena);
     return NULL;
+  }
 
-  memcpy(copy, str, len);
+  arena->memory = mmap(NULL, arena->s_arena, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
 
-  return copy;
-}
+  // the mapping pins the object; the descriptor is no longer needed
+  close(fd);
 
-u64 arena_get_size(Arena* arena) {
-  return arena->s_arena;
-}
+  if (arena->memory == MAP_FAILED) {
+    free(arena);
+    return NULL;
+  }
 
-u64 arena_get_size_nodes_max(Arena* arena) {
-  return arena->max_nodes;
-}
+  arena->ptr       = __arena_get_base_ptr(arena);
+  arena->hwm       = 0;
+  arena->s_commit  = 0;
+  arena->tail      = NULL;
+  arena->s_live    = 0;
+  arena->align     = 1;
+  arena->n_allocs  = 0;
+  arena->backing   = ARENA_BACKING_SHM;
+  arena->huge      = 0;
+  arena->numa_node = -1;
+  arena->max_nodes = 1; // offsets must stay within the single shared mapping
+  arena->s_nodes   = 1;
+  arena->next      = NULL;
+  arena->cursor    = arena;
+
+  arena->index = (RangeIndex){ 0 };
+  if (!__range_index_insert(
+    &arena->index,
+    arena->memory, __alloc_utils_ptr_incr(arena->memory, arena->s_arena),
+    arena
+  )) {
+    munmap(arena->memory, arena->s_arena);
+    free(arena);
+    return NULL;
+  }
 
-u64 arena_get_size_nodes(Arena* arena) {
-  return arena->s_nodes;
+  return arena;
 }
 
-u64 arena_get_size_used(Arena* arena) {
+Arena* arena_create_ring(const u64 s_arena) {
+  Arena* arena = arena_create(s_arena, 1);
   if (arena == NULL)
-    return 0;
+    return NULL;
 
-  if (arena->memory == NULL)
-    return 0;
+  arena->backing = ARENA_BACKING_RING;
+  arena->tail    = arena->memory;
 
-  return __alloc_utils_ptr_diff(arena->ptr, arena->memory);
+  return arena;
 }
 
-bool arena_reset(Arena* arena) {
-  if (arena == NULL)
-    return false;
+// snapshot image layout: header, node table, then page-aligned payloads
+#define S_ARENA_IMG_MAGIC ((u64)0x31474D49414E5241ull) // "ARNAIMG1"
 
-  if (arena->memory == NULL)
+bool arena_serialize(Arena* arena, const int fd) {
+  if (arena == NULL || fd < 0)
     return false;
 
-  memset(arena->memory, 0, arena->s_arena);
-  arena->ptr = arena->memory;
+  u64 n_nodes = 0;
+  for (Arena* node = arena; node != NULL; node = node->next)
+    n_nodes++;
 
-  return true;
-}
+  const u64 header[4] = { S_ARENA_IMG_MAGIC, n_nodes, arena->max_nodes, arena->align };
 
-bool arena_destroy(Arena* arena) {
-  if (arena == NULL)
+  if (pwrite(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header))
     return false;
 
-  Arena* node = arena;
-  while (node != NULL) {
-    Arena* next = node->next;
-
-    if (node->memory)
-      free(node->memory);
-    free(node);
+  u64 off = sizeof(header);
+  u64 payload = __alloc_utils_page_align(sizeof(header) + n_nodes * 2 * S_WORD);
 
-    node = next;
-  }
+  for (Arena* node = arena; node != NULL; node = node->next) {
+    const u64 entry[2] = {
+      node->s_arena,
+      (u64)__alloc_utils_ptr_diff(node->ptr, node->memory)
+    };
 
-  return true;
-}
+    if (pwrite(fd, entry, sizeof(entry), (off_t)off) != (ssize_t)sizeof(entry))
+      return false;
 
-void arena_print(Arena* arena, FILE* file) {
-  if (arena == NULL)
-    return;
+    // only the used extent is written; the capacity hole stays sparse
+    if (entry[1] > 0 && pwrite(fd, node->memory, entry[1], (off_t)payload) != (ssize_t)entry[1])
+      return false;
 
-  if (file == NULL)
-    file = stdout;
+    off     += sizeof(entry);
+    payload += __alloc_utils_page_align(node->s_arena);
+  }
 
-  fprintf(file, "Arena* %p: {\n",              (void*)arena);
-  fprintf(file, "  size:        %zu bytes;\n", arena_get_size(arena));
-  fprintf(file, "  size used:   %zu bytes;\n", arena_get_size_used(arena));
-  fprintf(file, "  max nodes:   %zu;\n",       arena_get_size_nodes_max(arena));
-  fprintf(file, "  nº nodes:    %zu;\n}\n",      arena_get_size_nodes(arena));
+  // extend the file to cover the last node's full capacity for mmap
+  return ftruncate(fd, (off_t)payload) == 0;
 }
 
-// Public Pool
-
-Pool* pool_create(const u64 s_pool, const u64 s_block, const u64 max_nodes) {
-  if (s_pool == 0)
+Arena* arena_deserialize(const int fd) {
+  if (fd < 0)
     return NULL;
 
-  if (s_block < S_WORD)
+  u64 header[4];
+  if (pread(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header))
     return NULL;
 
-  Pool* pool = (Pool*)malloc(sizeof(struct pool));
-  if (pool == NULL)
+  if (header[0] != S_ARENA_IMG_MAGIC || header[1] == 0)
     return NULL;
 
-  pool->s_pool  = __alloc_utils_next_power_2(s_pool);
-  pool->s_block = __alloc_utils_next_power_2(s_block);
+  const u64 n_nodes = header[1];
 
-  const u64 s_fl_arena = __alloc_utils_min(MB(10), __alloc_utils_max(KB(1), pool->s_pool / 100));
-  pool->fl_arena = arena_create(s_fl_arena, 5);
+  Arena* head = NULL;
+  Arena* tail = NULL;
 
-  pool->free_list = NULL;
-  __pool_free_region_append(pool, pool->s_pool / pool->s_block, 0);
+  u64 off     = sizeof(header);
+  u64 payload = __alloc_utils_page_align(sizeof(header) + n_nodes * 2 * S_WORD);
 
-  pool->memory = calloc(1, __pool_size_memory(pool));
-  if (pool->memory == NULL) {
-    free(pool);
-    return NULL;
-  }
+  for (u64 i = 0; i < n_nodes; i++) {
+    u64 entry[2];
+    if (pread(fd, entry, sizeof(entry), (off_t)off) != (ssize_t)sizeof(entry))
+      goto fail;
 
-  pool->max_nodes = max_nodes;
-  pool->s_nodes = 1;
-  pool->next = NULL;
-  
-  return pool;
-}
+    if (entry[0] == 0 || entry[1] > entry[0])
+      goto fail;
 
-void* pool_alloc(Pool* pool, const u64 s_alloc) {
-  if (pool == NULL || s_alloc == 0 || s_alloc > pool->s_pool)
-    return NULL;
-  
-  u64 blocks = __pool_bytes_to_block(pool, s_alloc);
-  
-  Pool* node = pool;
-  u64 block_index;
-  
-  for (; true; node = node->next) {
-    if (__pool_free_region_find(node, blocks, &block_index))
-      break;
-    
-    if (node->next != NULL)
-      continue;
+    Arena* node = (Arena*)malloc(sizeof(struct arena));
+    if (node == NULL)
+      goto fail;
 
-    if (pool->s_nodes >= pool->max_nodes)
-      return NULL;
-    
-    node->next = pool_create(pool->s_pool, pool->s_block, pool->max_nodes);
-    if (node->next == NULL)
-      return NULL;
-    
-    pool->s_nodes++;
+    // copy-on-write mapping straight over the image: restore reads nothing
+    // up front and later writes never reach the file
+    node->memory = mmap(
+      NULL, entry[0],
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE,
+      fd, (off_t)payload
+    );
+    if (node->memory == MAP_FAILED) {
+      free(node);
+      goto fail;
+    }
+
+    node->s_arena   = entry[0];
+    node->ptr       = __alloc_utils_ptr_incr(node->memory, entry[1]);
+    node->hwm       = entry[1];
+    node->s_commit  = 0;
+    node->tail      = NULL;
+    node->s_live    = 0;
+    node->align     = header[3];
+    node->n_allocs  = 0;
+    node->backing   = ARENA_BACKING_MAP;
+    node->huge      = 0;
+    node->numa_node = -1;
+    node->max_nodes = header[2];
+    node->s_nodes   = 1;
+    node->next      = NULL;
+    node->cursor    = NULL;
+    node->index     = (RangeIndex){ 0 };
+
+    if (head == NULL)
+      head = node;
+    else
+      tail->next = node;
+    tail = node;
+
+    if (!__range_index_insert(
+      &head->index,
+      node->memory, __alloc_utils_ptr_incr(node->memory, node->s_arena),
+      node
+    ))
+      goto fail;
+
+    off     += sizeof(entry);
+    payload += __alloc_utils_page_align(entry[0]);
   }
-  
-  if (node == NULL)
-    return NULL;
-  
-  void* base = __pool_get_base_ptr(node);
-  void* ptr  = __alloc_utils_ptr_incr(
-    base,
-    block_index * (S_WORD + node->s_block) + S_WORD
-  );
 
-  u64* s_ptr = (u64*)__alloc_utils_ptr_decr(ptr, S_WORD);
-  *s_ptr = s_alloc;
-  
-  return ptr;
-}
+  head->s_nodes   = n_nodes;
+  head->max_nodes = __alloc_utils_max(header[2], n_nodes);
+  head->cursor    = head;
 
-void* pool_alloc_array(Pool* pool, const u64 s_obj, const u32 count) {
-  return pool_alloc(pool, (u64)count * s_obj);
-}
+  return head;
 
-void* pool_realloc(Pool* pool, void* ptr, const u64 s_realloc) {
-  if (pool == NULL)
-    return NULL;
+fail:
+  if (head != NULL)
+    arena_destroy(head);
+  return NULL;
+}
 
-  if (ptr == NULL)
-    return pool_alloc(pool, s_realloc);
-  
-  if (!__pool_ptr_in_pool(pool, ptr))
-    return NULL;
+u64 arena_offset_of(Arena* arena, const void* ptr) {
+  if (arena == NULL || ptr == NULL)
+    return (u64)-1;
 
-  void* new_ptr = pool_alloc(pool, s_realloc);
-  if (new_ptr == NULL)
-    return NULL;
+  Arena* node = arena;
+  if (!__arena_valid_alloc(&node, ptr))
+    return (u64)-1;
 
-  u64 old_size = *(u64*)__alloc_utils_ptr_decr(ptr, S_WORD);
+  // handles are head-relative and arena_ptr_at resolves against the head's
+  // base: an offset into a chained node would silently alias head memory on
+  // the way back, so refuse to mint one
+  if (node != arena)
+    return (u64)-1;
 
-  memcpy(new_ptr, ptr, __alloc_utils_min(old_size, s_realloc));
+  return __arena_get_index(node, ptr);
+}
 
-  if (!pool_free(pool, ptr)) {
-    (void)pool_free(pool, new_ptr);
+void* arena_ptr_at(Arena* arena, const u64 offset) {
+  if (arena == NULL || offset >= arena->s_arena)
     return NULL;
-  }
 
-  return new_ptr;
+  return __alloc_utils_ptr_incr(__arena_get_base_ptr(arena), offset);
 }
 
-char* pool_strdup(Pool* pool, char* str) {
-  if (str == NULL)
-    return NULL;
+bool arena_ring_release_until(Arena* arena, const void* ptr) {
+  if (arena == NULL || arena->backing != ARENA_BACKING_RING)
+    return false;
 
-  u64 len = strlen(str) + 1;
-  char* copy = (char*)pool_alloc(pool, len);
-  if (copy == NULL)
-    return NULL;
+  u8
+    *const base = (u8*)__arena_get_base_ptr(arena),
+    *const end  = (u8*)__alloc_utils_ptr_incr(base, arena->s_arena);
+
+  u8* tail = (u8*)arena->tail;
+  u64 live = arena->s_live;
+
+  while (live > 0) {
+    // cross the wrap gap: nothing lives between here and the buffer end
+    if (
+      (u64)__alloc_utils_ptr_diff(end, tail) < S_WORD ||
+      *(u64*)tail == ARENA_RING_WRAP
+    ) {
+      live -= (u64)__alloc_utils_ptr_diff(end, tail);
+      tail  = base;
+      continue;
+    }
 
-  memcpy(copy, str, len);
+    if (__alloc_utils_ptr_incr(tail, S_WORD) == ptr)
+      break;
 
-  return copy;
-}
+    const u64 s_alloc = ALLOC_SIZE(*(u64*)tail, __alloc_utils_ptr_incr(tail, S_WORD));
 
-u64 pool_get_size(Pool* pool) {
-  return pool->s_pool;
-}
+    live -= S_WORD + s_alloc;
+    tail  = __alloc_utils_ptr_incr(tail, S_WORD + s_alloc);
+  }
 
-u64 pool_get_size_nodes_max(Pool* pool) {
-  return pool->max_nodes;
+  // a pointer that is not a live entry releases nothing rather than draining
+  // the whole ring on a stale handle
+  if (ptr != NULL && live == 0)
+    return false;
+
+  arena->tail   = tail;
+  arena->s_live = live;
+
+  return true;
 }
 
-u64 pool_get_size_nodes(Pool* pool) {
-  return pool->s_nodes;
+void* arena_alloc(Arena* arena, const u64 s_alloc) {
+  return arena_alloc_aligned(arena, s_alloc, arena == NULL ? 1 : arena->align);
 }
 
-u64 pool_get_size_used(Pool* pool) {
-  if (pool == NULL)
-    return 0;
+void* arena_alloc_aligned(Arena* arena, const u64 s_alloc, const u64 align) {
+  if (arena == NULL || s_alloc == 0 || !__alloc_utils_is_power_2(align))
+    return NULL;
 
-  if (pool->memory == NULL)
-    return 0;
+  if (arena->backing == ARENA_BACKING_RING)
+    return __arena_ring_alloc(arena, s_alloc);
 
-  u64 total = 0;
+  ALLOC_TRACE_ENTER();
 
-  for (Pool* node = pool; node != NULL; node = node->next) {
-    u64 count = 0;
+  // worst-case footprint including the padding needed to reach 'align'
+  const u64 s_worst = s_alloc + align - 1;
 
-    for (
-      FreeRegion* region = node->free_list;
-      region != NULL;
-      count += region->s_blocks, region = region->next
-    );
+  Arena* node = arena->cursor != NULL ? arena->cursor : arena;
+  for (
+    ;
+    node->next != NULL && __arena_is_full(node, s_worst);
+    node = node->next
+  );
 
-    // doing it here to avoid overflow with multiplications
-    total += node->s_pool - count * pool->s_block;
-  }
+  if (node->next == NULL && __arena_is_full(node, s_worst)) {
+    if (arena->s_nodes >= arena->max_nodes)
+      return NULL;
 
-  return total;
-}
+    // grow geometrically so long-lived chains converge to a few big nodes,
+    // sizing up further if a single request outgrows even the doubled node
+    const u64 s_next = __alloc_utils_max(
+      2 * node->s_arena,
+      __alloc_utils_next_power_2(S_WORD + s_worst)
+    );
 
-bool pool_free(Pool* pool, void* ptr) {
-  if (pool == NULL)
-    return false;
+    node->next = arena->backing == ARENA_BACKING_MAP
+      ? __arena_create_map(s_next, arena->max_nodes, arena->huge, arena->numa_node)
+      : arena_create(s_next, arena->max_nodes);
 
-  if (ptr == NULL)
-    return false;
+    if (node->next == NULL)
+      return NULL;
 
-  u64* s_ptr = __alloc_utils_ptr_decr(ptr, S_WORD);
+    // register the new node with the head's ownership index
+    if (!__range_index_insert(
+      &arena->index,
+      node->next->memory,
+      __alloc_utils_ptr_incr(node->next->memory, node->next->s_arena),
+      node->next
+    )) {
+      arena_destroy(node->next);
+      node->next = NULL;
+      return NULL;
+    }
 
-  u64 s_alloc = *s_ptr;
-  if (s_alloc == 0)
-    return false;
+    node->next->align = arena->align;
 
-  if (!__pool_valid_alloc(&pool, ptr))
-    return false;
+    ALLOC_TRACE_COUNT(ALLOC_EVENT_ARENA_GROW, node->next->s_arena);
 
-  memset((void*)s_ptr, 0, S_WORD + s_alloc);
+    arena->s_nodes++;
 
-  const u64 
-    index  = __pool_get_index(pool, ptr),
-    blocks = __pool_bytes_to_block(pool, s_alloc);
+    node = node->next;
+  }
 
-  return __pool_free_region_update(pool, index, blocks);
-}
+  arena->cursor = node;
 
-bool pool_reset(Pool* pool) {
-  if (pool == NULL)
-    return false;
+  if (
+    node->backing == ARENA_BACKING_RESERVE &&
+    !__arena_commit(node, (u64)__alloc_utils_ptr_diff(node->ptr, node->memory) + S_WORD + s_worst)
+  )
+    return NULL;
 
-  if (pool->memory == NULL)
-    return false;
+  void* ptr = (void*)__alloc_utils_align_up(
+    (u64)(uintptr_t)node->ptr + S_WORD, align
+  );
 
-  for (Pool* node = pool; pool != NULL; pool = pool->next) {
-    arena_reset(node->fl_arena);
+  *(u64*)__alloc_utils_ptr_decr(ptr, S_WORD) = ALLOC_HEADER(s_alloc);
 
-    node->free_list = (FreeRegion*)arena_alloc(pool->fl_arena, sizeof(struct free_region));
-    assert(pool->free_list != NULL);
+  node->ptr = __alloc_utils_ptr_incr(ptr, s_alloc);
 
-    *node->free_list = (FreeRegion){
-      .start_block = 0,
-      .s_blocks    = node->s_pool / node->s_block,
-      .prev        = NULL,
-      .next        = NULL
-    };
+  const u64 used = (u64)__alloc_utils_ptr_diff(node->ptr, node->memory);
+  if (used > node->hwm)
+    node->hwm = used;
 
-    memset(node->memory, 0, __pool_size_memory(node));
-  }
+  node->n_allocs++;
 
-  return true;
+  ALLOC_TRACE_EMIT(ALLOC_EVENT_ARENA_ALLOC, s_alloc);
+
+  return ptr;
+}
+
+bool arena_set_align(Arena* arena, const u64 align) {
+  if (arena == NULL || !__alloc_utils_is_power_2(align))
+    return false;
+
+  for (Arena* node = arena; node != NULL; node = node->next)
+    node->align = align;
+
+  return true;
+}
+
+void* arena_alloc_array(Arena* arena, const u64 s_obj, const u32 count) {
+  return arena_alloc(arena, (u64)count * s_obj);
+}
+
+void* arena_realloc(Arena* arena, void* ptr, const u64 s_realloc) {
+  if (arena == NULL)
+    return NULL;
+
+  if (ptr == NULL)
+    return arena_alloc(arena, s_realloc);
+
+  Arena* node = arena;
+  if (!__arena_valid_alloc(&node, ptr))
+    return NULL;
+
+  u64* s_ptr = (u64*)__alloc_utils_ptr_decr(ptr, S_WORD);
+  const u64 old_size = ALLOC_SIZE(*s_ptr, ptr);
+
+  // most recent allocation in its node: resize by moving the cursor, no copy
+  // (never on a ring, where the bump cursor cannot move without the live
+  // window and release walk going out of sync)
+  if (
+    s_realloc > 0 && arena->backing != ARENA_BACKING_RING &&
+    __alloc_utils_ptr_incr(ptr, old_size) == node->ptr
+  ) {
+    const u64 new_used =
+      (u64)__alloc_utils_ptr_diff(ptr, node->memory) + s_realloc;
+
+    if (
+      new_used <= node->s_arena &&
+      (node->backing != ARENA_BACKING_RESERVE || __arena_commit(node, new_used))
+    ) {
+      *s_ptr = ALLOC_HEADER(s_realloc);
+      node->ptr = __alloc_utils_ptr_incr(ptr, s_realloc);
+
+      if (new_used > node->hwm)
+        node->hwm = new_used;
+
+      return ptr;
+    }
+  }
+
+  void* new_ptr = arena_alloc(arena, s_realloc);
+  if (new_ptr == NULL)
+    return NULL;
+
+  memcpy(new_ptr, ptr, __alloc_utils_min(old_size, s_realloc));
+
+  return new_ptr;
+}
+
+u64 arena_alloc_batch(Arena* arena, const u64 s_obj, const u64 count, void** out) {
+  if (arena == NULL || s_obj == 0 || count == 0 || out == NULL)
+    return 0;
+
+  // a per-object default alignment defeats the shared carve, and a ring must
+  // account every entry in its live window: take the slow path
+  if (arena->align > 1 || arena->backing == ARENA_BACKING_RING) {
+    u64 n = 0;
+    for (; n < count && (out[n] = arena_alloc(arena, s_obj)) != NULL; n++);
+    return n;
+  }
+
+  u64 n = 0;
+  while (n < count) {
+    // let arena_alloc run the node search / growth / commit once per run
+    void* ptr = arena_alloc(arena, s_obj);
+    if (ptr == NULL)
+      return n;
+
+    out[n++] = ptr;
+
+    // the cursor node owns the run: bump it directly while it has room
+    Arena* node = arena->cursor;
+
+    while (
+      n < count && !__arena_is_full(node, s_obj) &&
+      (
+        node->backing != ARENA_BACKING_RESERVE ||
+        __arena_commit(node, (u64)__alloc_utils_ptr_diff(node->ptr, node->memory) + S_WORD + s_obj)
+      )
+    ) {
+      void* obj = __alloc_utils_ptr_incr(node->ptr, S_WORD);
+
+      *(u64*)node->ptr = ALLOC_HEADER(s_obj);
+      node->ptr = __alloc_utils_ptr_incr(obj, s_obj);
+      node->n_allocs++;
+
+      out[n++] = obj;
+    }
+
+    const u64 used = (u64)__alloc_utils_ptr_diff(node->ptr, node->memory);
+    if (used > node->hwm)
+      node->hwm = used;
+  }
+
+  return n;
+}
+
+char* arena_strdup(Arena* arena, char* str) {
+  if (str == NULL)
+    return NULL;
+
+  u64 len = strlen(str) + 1;
+  char* copy = (char*)arena_alloc(arena, len);
+  if (copy == NULL)
+    return NULL;
+
+  memcpy(copy, str, len);
+
+  return copy;
+}
+
+char* arena_sprintf(Arena* arena, const char* fmt, ...) {
+  if (arena == NULL || fmt == NULL)
+    return NULL;
+
+  va_list args;
+
+  // fast path: format straight into the cursor node's free tail and claim
+  // exactly the bytes written. Skipped when a default alignment is set,
+  // since the tail position would not honor it, and on a ring, whose live
+  // window is only maintained by __arena_ring_alloc
+  if (arena->align <= 1 && arena->backing != ARENA_BACKING_RING) {
+    Arena* node = arena->cursor != NULL ? arena->cursor : arena;
+
+    const u64 used  = (u64)__alloc_utils_ptr_diff(node->ptr, node->memory);
+    const u64 avail =
+      (node->backing == ARENA_BACKING_RESERVE ? node->s_commit : node->s_arena) - used;
+
+    if (avail > S_WORD) {
+      char* str = (char*)__alloc_utils_ptr_incr(node->ptr, S_WORD);
+
+      va_start(args, fmt);
+      const int len = vsnprintf(str, avail - S_WORD, fmt, args);
+      va_end(args);
+
+      if (len < 0)
+        return NULL;
+
+      if ((u64)len + 1 <= avail - S_WORD) {
+        *(u64*)node->ptr = ALLOC_HEADER((u64)len + 1);
+        node->ptr = __alloc_utils_ptr_incr(str, (u64)len + 1);
+
+        if (used + S_WORD + (u64)len + 1 > node->hwm)
+          node->hwm = used + S_WORD + (u64)len + 1;
+
+        node->n_allocs++;
+
+        return str;
+      }
+    }
+  }
+
+  // slow path: measure, allocate, format again
+  va_start(args, fmt);
+  const int len = vsnprintf(NULL, 0, fmt, args);
+  va_end(args);
+
+  if (len < 0)
+    return NULL;
+
+  char* str = (char*)arena_alloc(arena, (u64)len + 1);
+  if (str == NULL)
+    return NULL;
+
+  va_start(args, fmt);
+  vsnprintf(str, (u64)len + 1, fmt, args);
+  va_end(args);
+
+  return str;
+}
+
+ArenaStringBuilder arena_sb_create(Arena* arena) {
+  return (ArenaStringBuilder){ .arena = arena, .str = NULL, .len = 0, .cap = 0 };
+}
+
+bool arena_sb_append(ArenaStringBuilder* sb, const char* str) {
+  if (sb == NULL || sb->arena == NULL || str == NULL)
+    return false;
+
+  const u64 len = strlen(str);
+  if (!__arena_sb_reserve(sb, len))
+    return false;
+
+  memcpy(sb->str + sb->len, str, len + 1);
+  sb->len += len;
+
+  return true;
+}
+
+bool arena_sb_append_char(ArenaStringBuilder* sb, const char c) {
+  if (sb == NULL || sb->arena == NULL || !__arena_sb_reserve(sb, 1))
+    return false;
+
+  sb->str[sb->len++] = c;
+  sb->str[sb->len]   = '\0';
+
+  return true;
+}
+
+bool arena_sb_appendf(ArenaStringBuilder* sb, const char* fmt, ...) {
+  if (sb == NULL || sb->arena == NULL || fmt == NULL)
+    return false;
+
+  va_list args;
+
+  // format into the spare capacity first; grow and re-run only on a miss
+  va_start(args, fmt);
+  const int len = vsnprintf(
+    sb->str == NULL ? NULL : sb->str + sb->len, sb->cap - sb->len, fmt, args
+  );
+  va_end(args);
+
+  if (len < 0)
+    return false;
+
+  if ((u64)len + 1 <= sb->cap - sb->len) {
+    sb->len += (u64)len;
+    return true;
+  }
+
+  if (!__arena_sb_reserve(sb, (u64)len)) {
+    // the probe may have truncated into the buffer: restore the terminator
+    if (sb->str != NULL)
+      sb->str[sb->len] = '\0';
+    return false;
+  }
+
+  va_start(args, fmt);
+  vsnprintf(sb->str + sb->len, sb->cap - sb->len, fmt, args);
+  va_end(args);
+
+  sb->len += (u64)len;
+
+  return true;
+}
+
+char* arena_sb_finish(ArenaStringBuilder* sb) {
+  if (sb == NULL || sb->arena == NULL)
+    return NULL;
+
+  if (sb->str == NULL) {
+    char* empty = (char*)arena_alloc(sb->arena, 1);
+    if (empty != NULL)
+      *empty = '\0';
+    return empty;
+  }
+
+  // hand the slack back: in-place when the buffer is still the most recent
+  // allocation, which is the common build-then-finish flow
+  char* str = (char*)arena_realloc(sb->arena, sb->str, sb->len + 1);
+  if (str == NULL)
+    str = sb->str;
+
+  sb->str = NULL;
+  sb->len = sb->cap = 0;
+
+  return str;
+}
+
+u64 arena_get_size(Arena* arena) {
+  return arena->s_arena;
+}
+
+u64 arena_get_size_nodes_max(Arena* arena) {
+  return arena->max_nodes;
+}
+
+u64 arena_get_size_nodes(Arena* arena) {
+  return arena->s_nodes;
+}
+
+u64 arena_get_size_used(Arena* arena) {
+  if (arena == NULL)
+    return 0;
+
+  if (arena->memory == NULL)
+    return 0;
+
+  u64 total = 0;
+  for (Arena* node = arena; node != NULL; node = node->next)
+    total += node->backing == ARENA_BACKING_RING
+      ? node->s_live
+      : (u64)__alloc_utils_ptr_diff(node->ptr, node->memory);
+
+  return total;
+}
+
+ArenaStats arena_get_stats(Arena* arena) {
+  ArenaStats stats = { 0 };
+
+  if (arena == NULL)
+    return stats;
+
+  for (Arena* node = arena; node != NULL; node = node->next) {
+    stats.s_total  += node->s_arena;
+    stats.s_used   += node->backing == ARENA_BACKING_RING
+      ? node->s_live
+      : (u64)__alloc_utils_ptr_diff(node->ptr, node->memory);
+    stats.s_peak   += node->hwm;
+    stats.n_allocs += node->n_allocs;
+  }
+
+  stats.s_nodes = arena->s_nodes;
+
+  return stats;
+}
+
+ArenaMark arena_save(Arena* arena) {
+  // a ring's release cursor invalidates marks as old entries retire
+  if (arena == NULL || arena->backing == ARENA_BACKING_RING)
+    return (ArenaMark){ .node = NULL, .ptr = NULL };
+
+  // mark the cursor node: allocation starts there and only moves forward,
+  // so nothing can land before the mark between save and restore
+  Arena* node = arena->cursor != NULL ? arena->cursor : arena;
+
+  return (ArenaMark){ .node = node, .ptr = node->ptr };
+}
+
+bool arena_restore(Arena* arena, const ArenaMark mark) {
+  if (
+    arena == NULL || mark.node == NULL || mark.ptr == NULL ||
+    arena->backing == ARENA_BACKING_RING
+  )
+    return false;
+
+  /*
+   * Rewind is O(nodes past the mark) and performs no zeroing: the rolled-back
+   * space is handed out again as-is, so restored scratch memory is NOT
+   * guaranteed to be zero. The mark was taken at the cursor node, so every
+   * allocation made since the save sits at or past it and is rolled back.
+   */
+  Arena* node = arena;
+  for (; node != NULL && node != mark.node; node = node->next);
+
+  if (node == NULL)
+    return false;
+
+  const u8
+    *base = __arena_get_base_ptr(node),
+    *end  = __alloc_utils_ptr_incr(base, node->s_arena);
+
+  if ((u8*)mark.ptr < base || (u8*)mark.ptr > end || (u8*)mark.ptr > (u8*)node->ptr)
+    return false;
+
+  node->ptr = mark.ptr;
+
+  arena->cursor = node;
+
+  for (node = node->next; node != NULL; node = node->next)
+    node->ptr = __arena_get_base_ptr(node);
+
+  return true;
+}
+
+bool arena_reset(Arena* arena) {
+  if (arena == NULL)
+    return false;
+
+  if (arena->memory == NULL)
+    return false;
+
+  // cost is proportional to bytes ever used, not bytes reserved
+  for (Arena* node = arena; node != NULL; node = node->next) {
+    if (node->backing == ARENA_BACKING_RESERVE)
+      // return the touched pages; they read back as zero on next use
+      madvise(node->memory, __alloc_utils_page_align(node->hwm), MADV_DONTNEED);
+    else
+      memset(node->memory, 0, node->hwm);
+
+    node->ptr    = node->memory;
+    node->hwm    = 0;
+    node->tail   = node->memory;
+    node->s_live = 0;
+  }
+
+  arena->cursor = arena;
+
+  return true;
+}
+
+bool arena_reset_fast(Arena* arena) {
+  if (arena == NULL)
+    return false;
+
+  if (arena->memory == NULL)
+    return false;
+
+  // rewind only: recycled memory is handed out again without being zeroed
+  for (Arena* node = arena; node != NULL; node = node->next) {
+    node->ptr    = node->memory;
+    node->tail   = node->memory;
+    node->s_live = 0;
+  }
+
+  arena->cursor = arena;
+
+  return true;
+}
+
+u64 arena_trim(Arena* arena) {
+  if (arena == NULL)
+    return 0;
+
+  u64 released = 0;
+
+  // the head is never released; empty chain nodes go back to the OS
+  for (Arena* node = arena; node->next != NULL; ) {
+    Arena* next = node->next;
+
+    if (next->ptr != next->memory) {
+      node = next;
+      continue;
+    }
+
+    node->next = next->next;
+
+    __range_index_remove(&arena->index, next->memory);
+
+    if (arena->cursor == next)
+      arena->cursor = arena;
+
+    if (next->backing == ARENA_BACKING_HEAP)
+      free(next->memory);
+    else
+      munmap(next->memory, next->s_arena);
+
+    __range_index_dispose(&next->index);
+    free(next);
+
+    arena->s_nodes--;
+    released++;
+  }
+
+  // a reserve-backed arena can also decommit the pages past its cursor
+  if (arena->backing == ARENA_BACKING_RESERVE) {
+    const u64 used = __alloc_utils_page_align(
+      (u64)__alloc_utils_ptr_diff(arena->ptr, arena->memory)
+    );
+
+    if (used < arena->s_commit) {
+      void* tail = __alloc_utils_ptr_incr(arena->memory, used);
+
+      madvise(tail, arena->s_commit - used, MADV_DONTNEED);
+      mprotect(tail, arena->s_commit - used, PROT_NONE);
+
+      arena->s_commit = used;
+      if (arena->hwm > used)
+        arena->hwm = used;
+    }
+  }
+
+  return released;
+}
+
+bool arena_destroy(Arena* arena) {
+  if (arena == NULL)
+    return false;
+
+  Arena* node = arena;
+  while (node != NULL) {
+    Arena* next = node->next;
+
+    if (node->memory) {
+      if (node->backing == ARENA_BACKING_HEAP || node->backing == ARENA_BACKING_RING)
+        free(node->memory);
+      else
+        munmap(node->memory, node->s_arena);
+    }
+    __range_index_dispose(&node->index);
+    free(node);
+
+    node = next;
+  }
+
+  return true;
+}
+
+void arena_print(Arena* arena, FILE* file) {
+  if (arena == NULL)
+    return;
+
+  if (file == NULL)
+    file = stdout;
+
+  const ArenaStats stats = arena_get_stats(arena);
+
+  fprintf(file, "Arena* %p: {\n",              (void*)arena);
+  fprintf(file, "  size:        %zu bytes;\n", stats.s_total);
+  fprintf(file, "  size used:   %zu bytes;\n", stats.s_used);
+  fprintf(file, "  size peak:   %zu bytes;\n", stats.s_peak);
+  fprintf(file, "  nº allocs:   %zu;\n",         stats.n_allocs);
+  fprintf(file, "  max nodes:   %zu;\n",       arena_get_size_nodes_max(arena));
+  fprintf(file, "  nº nodes:    %zu;\n}\n",      stats.s_nodes);
+}
+
+// Public ArenaMT
+
+ArenaMT* arena_create_mt(const u64 s_arena, const u64 max_nodes, const u64 n_shards) {
+  if (s_arena == 0 || n_shards == 0)
+    return NULL;
+
+  ArenaMT* arena = (ArenaMT*)malloc(sizeof(struct arena_mt));
+  if (arena == NULL)
+    return NULL;
+
+  arena->n_shards = n_shards;
+  arena->shard_rr = 0;
+
+  arena->shards = (Arena**)calloc(n_shards, sizeof(Arena*));
+  if (arena->shards == NULL) {
+    free(arena);
+    return NULL;
+  }
+
+  for (u64 i = 0; i < n_shards; i++) {
+    arena->shards[i] = arena_create(s_arena, max_nodes);
+
+    if (arena->shards[i] == NULL) {
+      arena_destroy_mt(arena);
+      return NULL;
+    }
+  }
+
+  return arena;
+}
+
+void* arena_alloc_mt(ArenaMT* arena, const u64 s_alloc) {
+  if (arena == NULL || s_alloc == 0)
+    return NULL;
+
+  Arena* shard = arena->shards[__arena_mt_shard_id(arena)];
+  if (s_alloc > shard->s_arena)
+    return NULL;
+
+  for (Arena* node = shard; node != NULL; ) {
+    void* ptr = __arena_node_alloc_cas(node, s_alloc);
+    if (ptr != NULL)
+      return ptr;
+
+    Arena* next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+    if (next != NULL) {
+      node = next;
+      continue;
+    }
+
+    if (__atomic_load_n(&shard->s_nodes, __ATOMIC_RELAXED) >= shard->max_nodes)
+      return NULL;
+
+    Arena* fresh = arena_create(shard->s_arena, shard->max_nodes);
+    if (fresh == NULL)
+      return NULL;
+
+    Arena* expected = NULL;
+    if (__atomic_compare_exchange_n(
+      &node->next, &expected, fresh,
+      false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+    )) {
+      __atomic_fetch_add(&shard->s_nodes, 1, __ATOMIC_RELAXED);
+      node = fresh;
+    } else {
+      // another thread attached a node first: discard ours and follow theirs
+      arena_destroy(fresh);
+      node = expected;
+    }
+  }
+
+  return NULL;
+}
+
+u64 arena_get_size_shards(ArenaMT* arena) {
+  return arena->n_shards;
+}
+
+u64 arena_get_size_used_mt(ArenaMT* arena) {
+  if (arena == NULL)
+    return 0;
+
+  u64 total = 0;
+  for (u64 i = 0; i < arena->n_shards; i++)
+    total += arena_get_size_used(arena->shards[i]);
+
+  return total;
+}
+
+bool arena_reset_mt(ArenaMT* arena) {
+  if (arena == NULL)
+    return false;
+
+  // NOTE: not safe to call concurrently with arena_alloc_mt
+  for (u64 i = 0; i < arena->n_shards; i++)
+    if (!arena_reset(arena->shards[i]))
+      return false;
+
+  return true;
+}
+
+bool arena_destroy_mt(ArenaMT* arena) {
+  if (arena == NULL)
+    return false;
+
+  for (u64 i = 0; i < arena->n_shards; i++)
+    if (arena->shards[i] != NULL)
+      arena_destroy(arena->shards[i]);
+
+  free(arena->shards);
+  free(arena);
+
+  return true;
+}
+
+void arena_print_mt(ArenaMT* arena, FILE* file) {
+  if (arena == NULL)
+    return;
+
+  if (file == NULL)
+    file = stdout;
+
+  fprintf(file, "ArenaMT* %p: {\n",            (void*)arena);
+  fprintf(file, "  shards:      %zu;\n",       arena_get_size_shards(arena));
+  fprintf(file, "  size used:   %zu bytes;\n}\n", arena_get_size_used_mt(arena));
+}
+
+// Public Pool
+
+Pool* pool_create(const u64 s_pool, const u64 s_block, const u64 max_nodes) {
+  if (s_pool == 0)
+    return NULL;
+
+  if (s_block < S_WORD)
+    return NULL;
+
+  Pool* pool = (Pool*)malloc(sizeof(struct pool));
+  if (pool == NULL)
+    return NULL;
+
+  pool->s_pool    = __alloc_utils_next_power_2(s_pool);
+  pool->s_block   = __alloc_utils_next_power_2(s_block);
+  pool->align     = 1;
+  pool->wipe_free = true;
+
+  pool->s_blocks_used = 0;
+  pool->s_blocks_peak = 0;
+  pool->n_regions     = 0;
+  pool->n_allocs      = 0;
+  pool->n_frees       = 0;
+
+  const u64 s_fl_arena = __alloc_utils_min(MB(10), __alloc_utils_max(KB(1), pool->s_pool / 100));
+  pool->fl_arena = arena_create(s_fl_arena, 5);
+  pool->fl_free  = NULL;
+  pool->bitmap   = NULL;
+
+  pool->s_defer   = 0;
+  pool->n_pending = 0;
+  pool->pending   = NULL;
+
+  pool->s_run_hint = pool->s_pool / pool->s_block;
+  pool->s_route    = 0;
+
+  pool->memory = calloc(1, __pool_size_memory(pool));
+  if (pool->memory == NULL) {
+    arena_destroy(pool->fl_arena);
+    free(pool);
+    return NULL;
+  }
+
+  pool->bin_mask = 0;
+  memset(pool->bins, 0, sizeof(pool->bins));
+  __pool_free_region_append(pool, pool->s_pool / pool->s_block, 0);
+
+  pool->max_nodes = max_nodes;
+  pool->s_nodes = 1;
+  pool->next = NULL;
+
+  pool->index = (RangeIndex){ 0 };
+  if (!__range_index_insert(
+    &pool->index,
+    pool->memory, __alloc_utils_ptr_incr(pool->memory, __pool_size_memory(pool)),
+    pool
+  )) {
+    free(pool->memory);
+    arena_destroy(pool->fl_arena);
+    free(pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+Pool* pool_create_bitmap(const u64 s_pool, const u64 s_block, const u64 max_nodes) {
+  Pool* pool = pool_create(s_pool, s_block, max_nodes);
+  if (pool == NULL)
+    return NULL;
+
+  pool->bitmap = (u64*)calloc(__pool_bitmap_words(pool), sizeof(u64));
+  if (pool->bitmap == NULL) {
+    pool_destroy(pool);
+    return NULL;
+  }
+
+  // drop the free-list machinery pool_create set up: the initial region, its
+  // boundary tags and the metadata arena are all unused in bitmap mode
+  const u64 bin = __pool_bin_index(pool->s_pool / pool->s_block);
+  while (pool->bins[bin] != NULL)
+    __pool_unlink_region(pool, pool->bins[bin]);
+
+  arena_destroy(pool->fl_arena);
+  pool->fl_arena = NULL;
+
+  __pool_bitmap_pad(pool);
+
+  return pool;
+}
+
+void* pool_alloc(Pool* pool, const u64 s_alloc) {
+  return pool_alloc_aligned(pool, s_alloc, pool == NULL ? 1 : pool->align);
+}
+
+void* pool_alloc_aligned(Pool* pool, const u64 s_alloc, const u64 align) {
+  if (pool == NULL || s_alloc == 0)
+    return NULL;
+
+  return pool_alloc_blocks(pool, s_alloc, __pool_bytes_to_block(pool, s_alloc), align);
+}
+
+void* pool_alloc_blocks(Pool* pool, const u64 s_alloc, const u64 blocks, const u64 align) {
+  if (
+    pool == NULL || s_alloc == 0 || s_alloc > pool->s_pool ||
+    blocks == 0 || !__alloc_utils_is_power_2(align)
+  )
+    return NULL;
+
+  // a wrong compile-time count would corrupt the block accounting: fail
+  // soft like the other entry points (pool_create rounds s_block up to a
+  // power of two, so an unrounded literal lands here)
+  if (blocks != __pool_bytes_to_block(pool, s_alloc))
+    return NULL;
+
+  ALLOC_TRACE_ENTER();
+
+  Pool* node = NULL;
+  u64 block_index = 0;
+
+  // routed small allocation: pick the node with the tightest sufficient run
+  // so large contiguous runs elsewhere stay intact for big requests
+  if (pool->s_route > 0 && s_alloc <= pool->s_route) {
+    Pool* best = NULL;
+
+    for (Pool* n = pool; n != NULL; n = n->next)
+      if (
+        n->s_run_hint >= blocks &&
+        (best == NULL || n->s_run_hint < best->s_run_hint)
+      )
+        best = n;
+
+    // a stale hint can still miss: fall back to the ordered walk below
+    if (
+      best != NULL &&
+      __pool_free_region_find_aligned(best, blocks, align, &block_index)
+    )
+      node = best;
+  }
+
+  if (node == NULL) for (node = pool; true; node = node->next) {
+    if (__pool_free_region_find_aligned(node, blocks, align, &block_index))
+      break;
+
+    // a miss reclaims this node's deferred frees, then retries once
+    if (node->n_pending > 0) {
+      __pool_pending_flush(node);
+
+      if (__pool_free_region_find_aligned(node, blocks, align, &block_index))
+        break;
+    }
+
+    if (node->next != NULL)
+      continue;
+
+    if (pool->s_nodes >= pool->max_nodes)
+      return NULL;
+
+    node->next = pool->bitmap != NULL
+      ? pool_create_bitmap(pool->s_pool, pool->s_block, pool->max_nodes)
+      : pool_create(pool->s_pool, pool->s_block, pool->max_nodes);
+    if (node->next == NULL)
+      return NULL;
+
+    // register the new node with the head's ownership index
+    if (!__range_index_insert(
+      &pool->index,
+      node->next->memory,
+      __alloc_utils_ptr_incr(node->next->memory, __pool_size_memory(node->next)),
+      node->next
+    )) {
+      pool_destroy(node->next);
+      node->next = NULL;
+      return NULL;
+    }
+
+    node->next->wipe_free = pool->wipe_free;
+    node->next->align     = pool->align;
+    node->next->s_defer   = pool->s_defer;
+    node->next->s_route   = pool->s_route;
+
+    ALLOC_TRACE_COUNT(ALLOC_EVENT_POOL_GROW, node->next->s_pool);
+
+    pool->s_nodes++;
+  }
+
+  if (node == NULL)
+    return NULL;
+
+  void* base = __pool_get_base_ptr(node);
+  void* ptr  = __alloc_utils_ptr_incr(
+    base,
+    block_index * (S_WORD + node->s_block) + S_WORD
+  );
+
+  u64* s_ptr = (u64*)__alloc_utils_ptr_decr(ptr, S_WORD);
+  *s_ptr = ALLOC_HEADER(s_alloc);
+
+  node->n_allocs++;
+
+  ALLOC_TRACE_EMIT(ALLOC_EVENT_POOL_ALLOC, s_alloc);
+
+  return ptr;
+}
+
+u64 pool_get_align(Pool* pool) {
+  return pool == NULL ? 1 : pool->align;
+}
+
+bool pool_set_align(Pool* pool, const u64 align) {
+  if (pool == NULL || !__alloc_utils_is_power_2(align))
+    return false;
+
+  for (Pool* node = pool; node != NULL; node = node->next)
+    node->align = align;
+
+  return true;
+}
+
+void* pool_alloc_array(Pool* pool, const u64 s_obj, const u32 count) {
+  return pool_alloc(pool, (u64)count * s_obj);
+}
+
+void* pool_realloc(Pool* pool, void* ptr, const u64 s_realloc) {
+  if (pool == NULL)
+    return NULL;
+
+  if (ptr == NULL)
+    return pool_alloc(pool, s_realloc);
+
+  Pool* owner = pool;
+  if (!__pool_valid_alloc(&owner, ptr))
+    return NULL;
+
+  if (s_realloc > 0) {
+    void* in_place = __pool_realloc_in_place(owner, ptr, s_realloc);
+    if (in_place != NULL)
+      return in_place;
+  }
+
+  void* new_ptr = pool_alloc(pool, s_realloc);
+  if (new_ptr == NULL)
+    return NULL;
+
+  u64 old_size = ALLOC_SIZE(*(u64*)__alloc_utils_ptr_decr(ptr, S_WORD), ptr);
+
+  memcpy(new_ptr, ptr, __alloc_utils_min(old_size, s_realloc));
+
+  if (!pool_free(pool, ptr)) {
+    (void)pool_free(pool, new_ptr);
+    return NULL;
+  }
+
+  return new_ptr;
+}
+
+u64 pool_alloc_batch(Pool* pool, const u64 s_obj, const u64 count, void** out) {
+  if (
+    pool == NULL || s_obj == 0 || count == 0 || out == NULL ||
+    s_obj > pool->s_pool
+  )
+    return 0;
+
+  // a per-object default alignment defeats the shared carve — the run's
+  // objects are packed back to back — so take the per-object path, which
+  // honors pool->align
+  if (pool->align > 1) {
+    u64 n = 0;
+    for (; n < count && (out[n] = pool_alloc(pool, s_obj)) != NULL; n++);
+    return n;
+  }
+
+  const u64 blocks = __pool_bytes_to_block(pool, s_obj);
+
+  u64 n   = 0;
+  u64 run = count;
+
+  while (n < count) {
+    if (run > count - n)
+      run = count - n;
+
+    if (run > 1) {
+      // one search for the whole run; every object stays individually freeable
+      u64 index;
+      Pool* node = pool;
+      for (; node != NULL; node = node->next)
+        if (__pool_free_region_find(node, run * blocks, &index))
+          break;
+
+      if (node == NULL) {
+        // no region holds the run: shrink the carve and retry
+        run /= 2;
+        continue;
+      }
+
+      for (u64 i = 0; i < run; i++) {
+        void* ptr = __alloc_utils_ptr_incr(
+          __pool_get_base_ptr(node),
+          (index + i * blocks) * (S_WORD + node->s_block) + S_WORD
+        );
+
+        *(u64*)__alloc_utils_ptr_decr(ptr, S_WORD) = ALLOC_HEADER(s_obj);
+
+        node->n_allocs++;
+        out[n++] = ptr;
+      }
+
+      continue;
+    }
+
+    // run of one: plain allocation, which can also grow the chain
+    void* ptr = pool_alloc(pool, s_obj);
+    if (ptr == NULL)
+      return n;
+
+    out[n++] = ptr;
+  }
+
+  return n;
+}
+
+static int __pool_ptr_cmp(const void* a, const void* b) {
+  const u8
+    *x = *(const u8* const*)a,
+    *y = *(const u8* const*)b;
+
+  return x < y ? -1 : x > y;
+}
+
+bool pool_free_batch(Pool* pool, void** ptrs, const u64 count) {
+  if (pool == NULL || ptrs == NULL)
+    return false;
+
+  if (count == 0)
+    return true;
+
+  qsort(ptrs, count, sizeof(void*), __pool_ptr_cmp);
+
+  bool ok = true;
+
+  u64 i = 0;
+  while (i < count) {
+    Pool* node = pool;
+    u64
+      run_start  = 0,
+      run_end    = 0,
+      run_blocks = 0,
+      run_frees  = 0;
+
+    // gather the longest run of physically adjacent objects in one node,
+    // then hand it to the coalescer as a single region
+    while (i < count) {
+      void* ptr = ptrs[i];
+
+      Pool* owner = pool;
+      if (ptr == NULL || !__pool_valid_alloc(&owner, ptr))
+        break;
+
+      if (run_frees > 0 && owner != node)
+        break;
+
+      u64* s_ptr = __alloc_utils_ptr_decr(ptr, S_WORD);
+
+      const u64 s_alloc = ALLOC_SIZE(*s_ptr, ptr);
+      if (s_alloc == 0)
+        break;
+
+      const u64 index = __pool_get_index(owner, ptr);
+      if (run_frees > 0 && index != run_end)
+        break;
+
+#ifdef ALLOC_DEBUG
+      *s_ptr = ALLOC_HEADER_FREED;
+      memset(ptr, ALLOC_DEBUG_POISON, s_alloc);
+#else
+      if (owner->wipe_free)
+        memset((void*)s_ptr, 0, S_WORD + s_alloc);
+      else
+        *s_ptr = 0; // keep the double-free check without touching the payload
+#endif
+
+      if (run_frees == 0) {
+        node      = owner;
+        run_start = index;
+      }
+
+      run_end     = index + __pool_bytes_to_block(owner, s_alloc);
+      run_blocks += __pool_bytes_to_block(owner, s_alloc);
+      run_frees++;
+      i++;
+    }
+
+    if (run_frees == 0) {
+      // invalid entry: record the failure and move past it
+      ok = false;
+      i++;
+      continue;
+    }
+
+    if (__pool_free_region_update(node, run_start, run_blocks))
+      node->n_frees += run_frees;
+    else
+      ok = false;
+  }
+
+  return ok;
+}
+
+char* pool_strdup(Pool* pool, char* str) {
+  if (str == NULL)
+    return NULL;
+
+  u64 len = strlen(str) + 1;
+  char* copy = (char*)pool_alloc(pool, len);
+  if (copy == NULL)
+    return NULL;
+
+  memcpy(copy, str, len);
+
+  return copy;
+}
+
+u64 pool_get_size(Pool* pool) {
+  return pool->s_pool;
+}
+
+u64 pool_get_size_nodes_max(Pool* pool) {
+  return pool->max_nodes;
+}
+
+u64 pool_get_size_nodes(Pool* pool) {
+  return pool->s_nodes;
+}
+
+u64 pool_get_size_used(Pool* pool) {
+  if (pool == NULL)
+    return 0;
+
+  if (pool->memory == NULL)
+    return 0;
+
+  u64 total = 0;
+
+  for (Pool* node = pool; node != NULL; node = node->next)
+    total += node->s_blocks_used * node->s_block;
+
+  return total;
+}
+
+PoolStats pool_get_stats(Pool* pool) {
+  PoolStats stats = { 0 };
+
+  if (pool == NULL)
+    return stats;
+
+  for (Pool* node = pool; node != NULL; node = node->next) {
+    stats.s_total        += node->s_pool;
+    stats.s_used         += node->s_blocks_used * node->s_block;
+    stats.s_peak         += node->s_blocks_peak * node->s_block;
+    stats.n_allocs       += node->n_allocs;
+    stats.n_frees        += node->n_frees;
+    stats.n_free_regions += node->n_regions;
+
+    if (node->bitmap != NULL) {
+      u64 n_regions = 0, s_largest = 0;
+      __pool_bitmap_stats(node, &n_regions, &s_largest);
+
+      stats.n_free_regions += n_regions;
+      if (s_largest * node->s_block > stats.s_largest_region)
+        stats.s_largest_region = s_largest * node->s_block;
+    }
+
+    // only the topmost occupied bin can hold the largest region
+    if (node->bin_mask != 0) {
+      const u64 bin = (S_POOL_BINS - 1) - (u64)__builtin_clzll(node->bin_mask);
+
+      for (FreeRegion* r = node->bins[bin]; r != NULL; r = r->next)
+        if (r->s_blocks * node->s_block > stats.s_largest_region)
+          stats.s_largest_region = r->s_blocks * node->s_block;
+    }
+  }
+
+  stats.s_nodes = pool->s_nodes;
+
+  return stats;
+}
+
+bool pool_free(Pool* pool, void* ptr) {
+  if (pool == NULL)
+    return false;
+
+  if (ptr == NULL)
+    return false;
+
+  ALLOC_TRACE_ENTER();
+
+  // route to the owning node before touching the header, so a stray pointer
+  // can no longer fault on a pre-validation read
+  if (!__pool_valid_alloc(&pool, ptr))
+    return false;
+
+  u64* s_ptr = __alloc_utils_ptr_decr(ptr, S_WORD);
+
+  u64 s_alloc = ALLOC_SIZE(*s_ptr, ptr);
+
+#ifndef ALLOC_RELEASE
+  if (s_alloc == 0)
+    return false;
+#endif
+
+  // index before marking: __pool_get_index re-validates the header
+  const u64
+    index  = __pool_get_index(pool, ptr),
+    blocks = __pool_bytes_to_block(pool, s_alloc);
+
+#ifdef ALLOC_DEBUG
+  *s_ptr = ALLOC_HEADER_FREED;
+  memset(ptr, ALLOC_DEBUG_POISON, s_alloc);
+#else
+  if (pool->wipe_free)
+    memset((void*)s_ptr, 0, S_WORD + s_alloc);
+  else
+    *s_ptr = 0; // keep the double-free check without touching the payload
+#endif
+
+  // deferred mode: park the blocks, coalesce in a batch later
+  if (pool->s_defer > 0) {
+    FreeRegion* r = __pool_region_acquire(pool);
+
+    if (r != NULL) {
+      *r = (FreeRegion){
+        .start_block = index,
+        .s_blocks    = blocks,
+        .prev        = NULL,
+        .next        = pool->pending
+      };
+
+      pool->pending = r;
+      pool->n_pending++;
+      pool->n_frees++;
+
+      if (pool->n_pending >= pool->s_defer)
+        __pool_pending_flush(pool);
+
+      ALLOC_TRACE_EMIT(ALLOC_EVENT_POOL_FREE, s_alloc);
+
+      return true;
+    }
+    // no descriptor available: fall through to an immediate merge
+  }
+
+  if (!__pool_free_region_update(pool, index, blocks))
+    return false;
+
+  pool->n_frees++;
+
+  ALLOC_TRACE_EMIT(ALLOC_EVENT_POOL_FREE, s_alloc);
+
+  return true;
+}
+
+static int __pool_run_cmp(const void* a, const void* b) {
+  const u64
+    x = ((const FreeRegion*)a)->start_block,
+    y = ((const FreeRegion*)b)->start_block;
+
+  return x < y ? -1 : x > y;
+}
+
+bool pool_compact(Pool* pool, PoolRelocateFn relocate, void* ctx) {
+  if (pool == NULL)
+    return false;
+
+  for (Pool* node = pool; node != NULL; node = node->next) {
+    __pool_pending_flush(node);
+
+    const u64 total = node->s_pool / node->s_block;
+
+    /*
+     * Snapshot the free map up front: sliding live blocks overwrites the
+     * boundary tags (and, conceptually, the bitmap) of the space they move
+     * into, so the structures cannot be trusted mid-walk.
+     */
+    u64 n_runs = 0;
+    FreeRegion* runs = NULL;
+
+    if (node->bitmap != NULL) {
+      u64 s_largest = 0;
+      __pool_bitmap_stats(node, &n_runs, &s_largest);
+
+      if (n_runs > 0) {
+        runs = (FreeRegion*)malloc(n_runs * sizeof(FreeRegion));
+        if (runs == NULL)
+          return false;
+
+        u64 r = 0;
+        for (u64 block = 0; block < total; ) {
+          if (__pool_bitmap_test(node, block, 1)) {
+            block++;
+            continue;
+          }
+
+          u64 end = block;
+          for (; end < total && !__pool_bitmap_test(node, end, 1); end++);
+
+          runs[r++] = (FreeRegion){ .start_block = block, .s_blocks = end - block };
+          block = end;
+        }
+      }
+    } else if (node->n_regions > 0) {
+      runs = (FreeRegion*)malloc(node->n_regions * sizeof(FreeRegion));
+      if (runs == NULL)
+        return false;
+
+      for (u64 bin = 0; bin < S_POOL_BINS; bin++)
+        for (FreeRegion* r = node->bins[bin]; r != NULL; r = r->next)
+          runs[n_runs++] = *r;
+
+      qsort(runs, n_runs, sizeof(FreeRegion), __pool_run_cmp);
+    }
+
+    // slide: live allocations settle left, in address order
+    u64 dst = 0, run = 0;
+
+    for (u64 src = 0; src < total; ) {
+      if (run < n_runs && runs[run].start_block == src) {
+        src += runs[run].s_blocks;
+        run++;
+        continue;
+      }
+
+      const u64 s_alloc =
+        ALLOC_SIZE(*(u64*)__pool_block_ptr(node, src), __pool_block_ptr(node, src));
+      if (s_alloc == 0 || s_alloc > node->s_pool) {
+        // header corruption: abort rather than smear it across the node
+        free(runs);
+        return false;
+      }
+
+      const u64 blocks = __pool_bytes_to_block(node, s_alloc);
+
+      if (dst != src) {
+        void
+          *from = __pool_block_ptr(node, src),
+          *to   = __pool_block_ptr(node, dst);
+
+        memmove(to, from, blocks * (S_WORD + node->s_block));
+
+        if (relocate != NULL)
+          relocate(
+            ctx,
+            __alloc_utils_ptr_incr(from, S_WORD),
+            __alloc_utils_ptr_incr(to, S_WORD),
+            s_alloc
+          );
+      }
+
+      dst += blocks;
+      src += blocks;
+    }
+
+    free(runs);
+
+    // rebuild the free structures around the single tail region
+    if (node->wipe_free && dst < total)
+      memset(
+        __pool_block_ptr(node, dst), 0,
+        (total - dst) * (S_WORD + node->s_block)
+      );
+
+    node->bin_mask   = 0;
+    node->n_regions  = 0;
+    node->fl_free    = NULL;
+    node->pending    = NULL;
+    node->n_pending  = 0;
+    node->s_run_hint = total - dst;
+    memset(node->bins, 0, sizeof(node->bins));
+    arena_reset(node->fl_arena);
+
+    if (node->bitmap != NULL) {
+      memset(node->bitmap, 0, __pool_bitmap_words(node) * sizeof(u64));
+
+      if (dst > 0)
+        __pool_bitmap_set(node, 0, dst, true);
+
+      __pool_bitmap_pad(node);
+    } else if (dst < total) {
+      __pool_free_region_append(node, total - dst, dst);
+    }
+  }
+
+  return true;
+}
+
+bool pool_set_route(Pool* pool, const u64 s_small) {
+  if (pool == NULL)
+    return false;
+
+  for (Pool* node = pool; node != NULL; node = node->next)
+    node->s_route = s_small;
+
+  return true;
+}
+
+void pool_set_defer(Pool* pool, const u64 threshold) {
+  if (pool == NULL)
+    return;
+
+  for (Pool* node = pool; node != NULL; node = node->next) {
+    node->s_defer = threshold;
+
+    if (threshold == 0)
+      __pool_pending_flush(node);
+  }
+}
+
+bool pool_flush(Pool* pool) {
+  if (pool == NULL)
+    return false;
+
+  for (Pool* node = pool; node != NULL; node = node->next)
+    __pool_pending_flush(node);
+
+  return true;
+}
+
+void pool_set_wipe(Pool* pool, const bool wipe) {
+  if (pool == NULL)
+    return;
+
+  for (Pool* node = pool; node != NULL; node = node->next)
+    node->wipe_free = wipe;
+}
+
+bool pool_reset(Pool* pool) {
+  if (pool == NULL)
+    return false;
+
+  if (pool->memory == NULL)
+    return false;
+
+  for (Pool* node = pool; node != NULL; node = node->next) {
+    arena_reset(node->fl_arena);
+    node->fl_free   = NULL;
+    node->pending   = NULL;
+    node->n_pending = 0;
+
+    if (node->wipe_free)
+      memset(node->memory, 0, __pool_size_memory(node));
+
+    node->bin_mask      = 0;
+    node->n_regions     = 0;
+    node->s_blocks_used = 0;
+    node->s_blocks_peak = 0;
+    memset(node->bins, 0, sizeof(node->bins));
+
+    node->s_run_hint = node->s_pool / node->s_block;
+
+    if (node->bitmap != NULL) {
+      memset(node->bitmap, 0, __pool_bitmap_words(node) * sizeof(u64));
+      __pool_bitmap_pad(node);
+    } else {
+      __pool_free_region_append(node, node->s_pool / node->s_block, 0);
+    }
+  }
+
+  return true;
+}
+
+u64 pool_trim(Pool* pool) {
+  if (pool == NULL)
+    return 0;
+
+  u64 released = 0;
+
+  // the head is never released; nodes with no live blocks go back to the OS
+  for (Pool* node = pool; node->next != NULL; ) {
+    Pool* next = node->next;
+
+    __pool_pending_flush(next);
+
+    if (next->s_blocks_used != 0) {
+      node = next;
+      continue;
+    }
+
+    node->next = next->next;
+
+    __range_index_remove(&pool->index, next->memory);
+    __range_index_dispose(&next->index);
+
+    free(next->memory);
+    free(next->bitmap);
+    arena_destroy(next->fl_arena);
+    free(next);
+
+    pool->s_nodes--;
+    released++;
+  }
+
+  return released;
 }
 
 bool pool_destroy(Pool* pool) {
   if (pool == NULL)
     return false;
 
-  Pool* node = pool;
+  Pool* node = pool;
+  while (node != NULL) {
+    Pool* next = node->next;
+
+    __range_index_dispose(&node->index);
+
+    if (node->memory)
+      free(node->memory);
+    arena_destroy(node->fl_arena);
+    free(node->bitmap);
+    free(node);
+
+    node = next;
+  }
+
+  return true;
+}
+
+void pool_print(Pool* pool, FILE* file) {
+  if (pool == NULL)
+    return;
+
+  if (file == NULL)
+    file = stdout;
+
+  const PoolStats stats = pool_get_stats(pool);
+
+  fprintf(file, "Pool* %p: {\n",                     (void*)pool);
+  fprintf(file, "  size block:  %zu bytes;\n",       pool->s_block);
+  fprintf(file, "  size:        %zu bytes/node;\n",  pool_get_size(pool));
+  fprintf(file, "  size used:   %zu bytes total;\n", stats.s_used);
+  fprintf(file, "  size peak:   %zu bytes total;\n", stats.s_peak);
+  fprintf(file, "  nº allocs:   %zu;\n",               stats.n_allocs);
+  fprintf(file, "  nº frees:    %zu;\n",               stats.n_frees);
+  fprintf(file, "  free list:   %zu regions (largest %zu bytes);\n", stats.n_free_regions, stats.s_largest_region);
+  fprintf(file, "  max nodes:   %zu;\n",             pool_get_size_nodes_max(pool));
+  fprintf(file, "  nº nodes:    %zu;\n}\n",            stats.s_nodes);
+}
+
+// Public FixedPool
+
+FixedPool* pool_create_fixed(const u64 s_obj, const u64 count, const u64 max_nodes) {
+  if (s_obj == 0 || count == 0)
+    return NULL;
+
+  FixedPool* pool = (FixedPool*)malloc(sizeof(struct fixed_pool));
+  if (pool == NULL)
+    return NULL;
+
+  // a free slot must be able to hold the intrusive next pointer
+  pool->s_obj = __alloc_utils_max(s_obj, S_WORD);
+  pool->count = count;
+
+  pool->memory = calloc(count, pool->s_obj);
+  if (pool->memory == NULL) {
+    free(pool);
+    return NULL;
+  }
+
+  pool->s_init    = 0;
+  pool->s_used    = 0;
+  pool->free_head = NULL;
+  pool->max_nodes = max_nodes;
+  pool->s_nodes   = 1;
+  pool->next      = NULL;
+
+  return pool;
+}
+
+void* pool_fixed_alloc(FixedPool* pool) {
+  if (pool == NULL)
+    return NULL;
+
+  FixedPool* node = pool;
+  for (; true; node = node->next) {
+    if (node->free_head != NULL || node->s_init < node->count)
+      break;
+
+    if (node->next != NULL)
+      continue;
+
+    if (pool->s_nodes >= pool->max_nodes)
+      return NULL;
+
+    node->next = pool_create_fixed(pool->s_obj, pool->count, pool->max_nodes);
+    if (node->next == NULL)
+      return NULL;
+
+    pool->s_nodes++;
+  }
+
+  void* ptr;
+  if (node->free_head != NULL) {
+    ptr = node->free_head;
+    node->free_head = *(void**)ptr;
+    *(void**)ptr = NULL;
+  } else {
+    ptr = __alloc_utils_ptr_incr(node->memory, node->s_init * node->s_obj);
+    node->s_init++;
+  }
+
+  node->s_used++;
+
+  return ptr;
+}
+
+bool pool_fixed_free(FixedPool* pool, void* ptr) {
+  if (pool == NULL || ptr == NULL)
+    return false;
+
+  FixedPool* node = pool;
+  for (; node != NULL && !__pool_fixed_ptr_in_pool(node, ptr); node = node->next);
+
+  if (node == NULL)
+    return false;
+
+  *(void**)ptr = node->free_head;
+  node->free_head = ptr;
+
+  node->s_used--;
+
+  return true;
+}
+
+u64 pool_fixed_get_size(FixedPool* pool) {
+  return pool->s_obj * pool->count;
+}
+
+u64 pool_fixed_get_size_used(FixedPool* pool) {
+  if (pool == NULL)
+    return 0;
+
+  u64 total = 0;
+  for (FixedPool* node = pool; node != NULL; node = node->next)
+    total += node->s_used * node->s_obj;
+
+  return total;
+}
+
+bool pool_fixed_reset(FixedPool* pool) {
+  if (pool == NULL)
+    return false;
+
+  for (FixedPool* node = pool; node != NULL; node = node->next) {
+    memset(node->memory, 0, node->s_init * node->s_obj);
+
+    node->s_init    = 0;
+    node->s_used    = 0;
+    node->free_head = NULL;
+  }
+
+  return true;
+}
+
+bool pool_fixed_destroy(FixedPool* pool) {
+  if (pool == NULL)
+    return false;
+
+  FixedPool* node = pool;
   while (node != NULL) {
-    Pool* next = node->next;
+    FixedPool* next = node->next;
 
     if (node->memory)
       free(node->memory);
-    arena_destroy(node->fl_arena);
     free(node);
 
     node = next;
@@ -412,30 +2121,227 @@ bool pool_destroy(Pool* pool) {
   return true;
 }
 
-void pool_print(Pool* pool, FILE* file) {
+void pool_fixed_print(FixedPool* pool, FILE* file) {
   if (pool == NULL)
     return;
 
   if (file == NULL)
     file = stdout;
 
-  fprintf(file, "Pool* %p: {\n",                     (void*)pool);
-  fprintf(file, "  size block:  %zu bytes;\n",       pool->s_block);
-  fprintf(file, "  size:        %zu bytes/node;\n",  pool_get_size(pool));
-  fprintf(file, "  size used:   %zu bytes total;\n", pool_get_size_used(pool));
-  fprintf(file, "  max nodes:   %zu;\n",             pool_get_size_nodes_max(pool));
-  fprintf(file, "  nº nodes:    %zu;\n}\n",            pool_get_size_nodes(pool));
+  fprintf(file, "FixedPool* %p: {\n",                (void*)pool);
+  fprintf(file, "  size obj:    %zu bytes;\n",       pool->s_obj);
+  fprintf(file, "  size:        %zu bytes/node;\n",  pool_fixed_get_size(pool));
+  fprintf(file, "  size used:   %zu bytes total;\n", pool_fixed_get_size_used(pool));
+  fprintf(file, "  max nodes:   %zu;\n",             pool->max_nodes);
+  fprintf(file, "  nº nodes:    %zu;\n}\n",            pool->s_nodes);
+}
+
+// Public PoolMagazine
+
+PoolMagazine* pool_magazine_create(Pool* pool) {
+  if (pool == NULL)
+    return NULL;
+
+  PoolMagazine* mag = (PoolMagazine*)calloc(1, sizeof(struct pool_magazine));
+  if (mag == NULL)
+    return NULL;
+
+  mag->pool = pool;
+
+  return mag;
+}
+
+void* pool_magazine_alloc(PoolMagazine* mag, const u64 s_alloc) {
+  if (mag == NULL || s_alloc == 0)
+    return NULL;
+
+  u64 blocks = __pool_bytes_to_block(mag->pool, s_alloc);
+
+  // allocations above the cached classes go straight to the pool
+  if (blocks == 0 || blocks > S_MAG_CLASSES)
+    return pool_alloc(mag->pool, s_alloc);
+
+  u64 class = blocks - 1;
+
+  if (mag->count[class] == 0 && !__pool_magazine_refill(mag, class))
+    return NULL;
+
+  void* ptr = mag->rounds[class][--mag->count[class]];
+
+  // the cached block keeps its header word: retag it with the new size
+  *(u64*)__alloc_utils_ptr_decr(ptr, S_WORD) = ALLOC_HEADER(s_alloc);
+
+  return ptr;
+}
+
+bool pool_magazine_free(PoolMagazine* mag, void* ptr) {
+  if (mag == NULL || ptr == NULL)
+    return false;
+
+  u64 s_alloc = ALLOC_SIZE(*(u64*)__alloc_utils_ptr_decr(ptr, S_WORD), ptr);
+  if (s_alloc == 0)
+    return false;
+
+  u64 blocks = __pool_bytes_to_block(mag->pool, s_alloc);
+
+  if (blocks > S_MAG_CLASSES)
+    return pool_free(mag->pool, ptr);
+
+  u64 class = blocks - 1;
+
+  // cache full: flush half back to the shared free list in one batch
+  if (mag->count[class] == S_MAG_ROUNDS)
+    __pool_magazine_drain(mag, class, S_MAG_ROUNDS / 2);
+
+  mag->rounds[class][mag->count[class]++] = ptr;
+
+  return true;
+}
+
+bool pool_magazine_flush(PoolMagazine* mag) {
+  if (mag == NULL)
+    return false;
+
+  for (u64 class = 0; class < S_MAG_CLASSES; class++)
+    __pool_magazine_drain(mag, class, 0);
+
+  return true;
+}
+
+bool pool_magazine_destroy(PoolMagazine* mag) {
+  if (mag == NULL)
+    return false;
+
+  pool_magazine_flush(mag);
+  free(mag);
+
+  return true;
 }
 
 // ====================================# PRIVATE #======================================
 
 // Private Arena
 
+Arena* __arena_create_map(const u64 s_arena, const u64 max_nodes, const bool huge, const i32 numa_node) {
+  if (s_arena == 0)
+    return NULL;
+
+  Arena* arena = (Arena*)malloc(sizeof(struct arena));
+  if (arena == NULL)
+    return NULL;
+
+  arena->s_arena = __alloc_utils_page_align(__alloc_utils_next_power_2(s_arena));
+
+  const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+  arena->memory = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+  if (huge)
+    arena->memory = mmap(NULL, arena->s_arena, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+#endif
+
+  // no huge pages reserved (or not requested): map normally; for huge, the
+  // kernel is still advised to back the range with transparent huge pages
+  if (arena->memory == MAP_FAILED) {
+    arena->memory = mmap(NULL, arena->s_arena, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (arena->memory == MAP_FAILED) {
+      free(arena);
+      return NULL;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (huge)
+      madvise(arena->memory, arena->s_arena, MADV_HUGEPAGE);
+#endif
+  }
+
+  if (numa_node >= 0) {
+    const unsigned long nodemask = 1ul << numa_node;
+
+    if (syscall(SYS_mbind, arena->memory, arena->s_arena, MPOL_BIND, &nodemask, sizeof(nodemask) * 8 + 1, 0) != 0) {
+      munmap(arena->memory, arena->s_arena);
+      free(arena);
+      return NULL;
+    }
+  }
+
+  arena->ptr       = __arena_get_base_ptr(arena);
+  arena->hwm       = 0;
+  arena->s_commit  = 0;
+  arena->tail      = NULL;
+  arena->s_live    = 0;
+  arena->align     = 1;
+  arena->n_allocs  = 0;
+  arena->backing   = ARENA_BACKING_MAP;
+  arena->huge      = huge ? 1 : 0;
+  arena->numa_node = numa_node;
+  arena->max_nodes = max_nodes;
+  arena->s_nodes   = 1;
+  arena->next      = NULL;
+  arena->cursor    = arena;
+
+  arena->index = (RangeIndex){ 0 };
+  if (!__range_index_insert(
+    &arena->index,
+    arena->memory, __alloc_utils_ptr_incr(arena->memory, arena->s_arena),
+    arena
+  )) {
+    munmap(arena->memory, arena->s_arena);
+    free(arena);
+    return NULL;
+  }
+
+  return arena;
+}
+
+bool __arena_sb_reserve(ArenaStringBuilder* sb, const u64 need) {
+  if (sb->len + need + 1 <= sb->cap)
+    return true;
+
+  const u64 cap = __alloc_utils_max(
+    __alloc_utils_next_power_2(sb->len + need + 1), (u64)32
+  );
+
+  char* str = (char*)arena_realloc(sb->arena, sb->str, cap);
+  if (str == NULL)
+    return false;
+
+  sb->str = str;
+  sb->cap = cap;
+
+  return true;
+}
+
 bool __arena_is_full(Arena* arena, const u64 s_alloc) {
   assert(arena != NULL);
   return S_WORD + s_alloc > arena->s_arena - (u64)__alloc_utils_ptr_diff(arena->ptr, arena->memory);
 }
 
+bool __arena_commit(Arena* arena, const u64 needed) {
+  assert(arena != NULL);
+  assert(arena->backing == ARENA_BACKING_RESERVE);
+
+  if (needed <= arena->s_commit)
+    return true;
+
+  if (needed > arena->s_arena)
+    return false;
+
+  // double the committed extent to amortize mprotect calls
+  const u64 target = __alloc_utils_page_align(
+    __alloc_utils_min(arena->s_arena, __alloc_utils_max(2 * arena->s_commit, needed))
+  );
+
+  void* from = __alloc_utils_ptr_incr(arena->memory, arena->s_commit);
+  if (mprotect(from, target - arena->s_commit, PROT_READ | PROT_WRITE) != 0)
+    return false;
+
+  arena->s_commit = target;
+
+  return true;
+}
+
 bool __arena_ptr_in_arena(const Arena* arena, const void* ptr) {
   assert(arena != NULL);
   assert(ptr != NULL);
@@ -443,12 +2349,19 @@ bool __arena_ptr_in_arena(const Arena* arena, const void* ptr) {
   const u8
     *arena_base_ptr = __arena_get_base_ptr(arena),
     *arena_end_ptr  = __alloc_utils_ptr_incr(arena_base_ptr, arena->s_arena),
-    *alloc_start    = __alloc_utils_ptr_decr(ptr, S_WORD),
-    *alloc_end      = __alloc_utils_ptr_incr(ptr, *(u64*)alloc_start);
+    *alloc_start    = ptr;
+
+  // bounds come first: the header must not be read until the pointer is
+  // known to sit inside this node's span
+  if (
+    alloc_start < (const u8*)__alloc_utils_ptr_incr(arena_base_ptr, S_WORD) ||
+    alloc_start >= arena_end_ptr
+  )
+    return false;
+
+  const u64 s_alloc = ALLOC_SIZE(*(u64*)__alloc_utils_ptr_decr(ptr, S_WORD), ptr);
 
-  return 
-    alloc_start >= arena_base_ptr && 
-    alloc_end   <  arena_end_ptr;
+  return (u64)(arena_end_ptr - alloc_start) >= s_alloc;
 }
 
 bool __arena_valid_alloc(Arena** arena, const void* ptr) {
@@ -457,15 +2370,23 @@ bool __arena_valid_alloc(Arena** arena, const void* ptr) {
   if (ptr == NULL)
     return false; 
 
-  for (Arena* node = *arena; node != NULL; node = node->next) {
-    if (!__arena_ptr_in_arena(*arena, ptr))
-      continue;
-
-    *arena = node;
+#ifdef ALLOC_RELEASE
+  // trust the caller: resolve the owning node, skip the header checks
+  if ((*arena)->next == NULL)
     return true;
-  }
 
-  return false;
+  Arena* node = (Arena*)__range_index_find(&(*arena)->index, ptr);
+  if (node == NULL)
+    return false;
+#else
+  // one binary search of the head's range index instead of a chain walk
+  Arena* node = (Arena*)__range_index_find(&(*arena)->index, ptr);
+  if (node == NULL || !__arena_ptr_in_arena(node, ptr))
+    return false;
+#endif
+
+  *arena = node;
+  return true;
 }
 
 static inline u64 __arena_size_memory(const Arena* arena) {
@@ -489,6 +2410,126 @@ static inline void* __arena_get_base_ptr(const Arena* arena) {
   return arena->memory;
 }
 
+// Private ArenaMT
+
+u64 __arena_mt_shard_id(ArenaMT* arena) {
+  assert(arena != NULL);
+
+  /*
+   * Each thread is bound to a shard on its first allocation via an atomic
+   * round-robin ticket. The binding is per-thread (not per-arena): with
+   * n_shards >= thread count every thread owns its shard exclusively, and
+   * the CAS bump in __arena_node_alloc_cas keeps shared shards correct
+   * when there are more threads than shards.
+   */
+  static _Thread_local u64 ticket = (u64)-1;
+
+  if (ticket == (u64)-1)
+    ticket = __atomic_fetch_add(&arena->shard_rr, 1, __ATOMIC_RELAXED);
+
+  return ticket % arena->n_shards;
+}
+
+void* __arena_node_alloc_cas(Arena* node, const u64 s_alloc) {
+  assert(node != NULL);
+
+  for (;;) {
+    void* cur = __atomic_load_n(&node->ptr, __ATOMIC_ACQUIRE);
+
+    u64 used = (u64)__alloc_utils_ptr_diff(cur, node->memory);
+    if (S_WORD + s_alloc > node->s_arena - used)
+      return NULL;
+
+    void* next = __alloc_utils_ptr_incr(cur, S_WORD + s_alloc);
+    if (__atomic_compare_exchange_n(
+      &node->ptr, &cur, next,
+      false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+    )) {
+      *(u64*)cur = ALLOC_HEADER(s_alloc);
+
+      const u64 new_used = used + S_WORD + s_alloc;
+      for (
+        u64 hwm = __atomic_load_n(&node->hwm, __ATOMIC_RELAXED);
+        hwm < new_used &&
+        !__atomic_compare_exchange_n(
+          &node->hwm, &hwm, new_used,
+          false, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+        );
+      );
+
+      __atomic_fetch_add(&node->n_allocs, 1, __ATOMIC_RELAXED);
+
+      return __alloc_utils_ptr_incr(cur, S_WORD);
+    }
+  }
+}
+
+void* __arena_ring_alloc(Arena* arena, const u64 s_alloc) {
+  ALLOC_TRACE_ENTER();
+
+  // sizes are rounded to word multiples so headers stay aligned and the
+  // release walk can step from entry to entry
+  const u64 s_entry = S_WORD + __alloc_utils_align_up(s_alloc, S_WORD);
+
+  u8
+    *const base = (u8*)__arena_get_base_ptr(arena),
+    *const end  = (u8*)__alloc_utils_ptr_incr(base, arena->s_arena);
+
+  // empty ring: both cursors snap back to the base
+  if (arena->s_live == 0) {
+    arena->ptr  = base;
+    arena->tail = base;
+  }
+
+  u8
+    *head = (u8*)arena->ptr,
+    *tail = (u8*)arena->tail;
+
+  // head == tail is empty only when nothing is live; otherwise the window
+  // has lapped the buffer and the ring is exactly full
+  const bool wrapped =
+    head < tail || (head == tail && arena->s_live > 0);
+
+  if (!wrapped) {
+    // not wrapped: the free space runs from head to the buffer end
+    if (s_entry > (u64)__alloc_utils_ptr_diff(end, head)) {
+      // wrap: the end gap stays dead until the release cursor crosses it
+      const u64 gap = (u64)__alloc_utils_ptr_diff(end, head);
+
+      if (s_entry > (u64)__alloc_utils_ptr_diff(tail, base))
+        return NULL;
+
+      if (gap >= S_WORD)
+        *(u64*)head = ARENA_RING_WRAP;
+
+      arena->s_live += gap;
+      arena->hwm     = arena->s_arena;
+
+      head = base;
+    }
+  } else if (s_entry > (u64)__alloc_utils_ptr_diff(tail, head)) {
+    // wrapped: the free space is the hole behind the release cursor, and the
+    // head must never pass it
+    return NULL;
+  }
+
+  *(u64*)head = ALLOC_HEADER(s_entry - S_WORD);
+
+  void* ptr = __alloc_utils_ptr_incr(head, S_WORD);
+
+  arena->ptr     = __alloc_utils_ptr_incr(head, s_entry);
+  arena->s_live += s_entry;
+  arena->n_allocs++;
+
+  const u64 used = (u64)__alloc_utils_ptr_diff(arena->ptr, base);
+  if (used > arena->hwm)
+    arena->hwm = used;
+
+  ALLOC_TRACE_EMIT(ALLOC_EVENT_ARENA_ALLOC, s_alloc);
+
+  return ptr;
+}
+
 // Private Pool
 
 bool __pool_valid_alloc(Pool** pool, const void* ptr) {
@@ -497,115 +2538,326 @@ bool __pool_valid_alloc(Pool** pool, const void* ptr) {
   if (ptr == NULL)
     return false; 
 
-  for (Pool* node = *pool; node != NULL; node = node->next) {
-    if (!__pool_ptr_in_pool(*pool, ptr))
-      continue;
-
-    *pool = node;
+#ifdef ALLOC_RELEASE
+  // trust the caller: resolve the owning node, skip the header checks
+  if ((*pool)->next == NULL)
     return true;
-  }
 
-  return false;
+  Pool* node = (Pool*)__range_index_find(&(*pool)->index, ptr);
+  if (node == NULL)
+    return false;
+#else
+  // one binary search of the head's range index instead of a chain walk
+  Pool* node = (Pool*)__range_index_find(&(*pool)->index, ptr);
+  if (node == NULL || !__pool_ptr_in_pool(node, ptr))
+    return false;
+#endif
+
+  *pool = node;
+  return true;
 }
 
 bool __pool_ptr_in_pool(const Pool* pool, const void* ptr) {
   assert(pool != NULL);
   assert(ptr != NULL);
 
-  const u64 s_alloc = *(u64*)__alloc_utils_ptr_decr(ptr, S_WORD);
-
   const u8
     *pool_base_ptr = __pool_get_base_ptr(pool),
-    *pool_end_ptr  = __alloc_utils_ptr_incr(pool_base_ptr, pool->s_pool),
-    *alloc_start   = ptr,
-    *alloc_end     = __alloc_utils_ptr_incr(ptr, s_alloc);
+    *pool_end_ptr  = __alloc_utils_ptr_incr(pool_base_ptr, __pool_size_memory(pool)),
+    *alloc_start   = ptr;
+
+  // bounds come first: the header must not be read until the pointer is
+  // known to sit inside this node's span
+  if (
+    alloc_start < (const u8*)__alloc_utils_ptr_incr(pool_base_ptr, S_WORD) ||
+    alloc_start >= pool_end_ptr
+  )
+    return false;
+
+  void* header_addr = __alloc_utils_ptr_decr(ptr, S_WORD);
+
+#ifdef ALLOC_DEBUG
+  /*
+   * Immediate-free mode overwrites the FREED sentinel with the region's
+   * boundary tag the moment the block joins the free list, so a second free
+   * would trip the canary check below with the wrong report. A header slot
+   * holding a tag whose region starts at this very block can only mean the
+   * allocation was already freed: live debug headers carry the 0xA5 top
+   * byte, which is never a valid descriptor address.
+   */
+  const FreeRegion* region = __pool_region_tag_read(pool, header_addr);
+  if (region != NULL && __pool_block_ptr(pool, region->start_block) == header_addr) {
+    fprintf(stderr, "alloc: double free of %p\n", ptr);
+    abort();
+  }
+#endif
+
+  const u64 s_alloc = ALLOC_SIZE(*(u64*)header_addr, ptr);
+
+  return (u64)(pool_end_ptr - alloc_start) >= s_alloc;
+}
 
-  return 
-    alloc_start >= pool_base_ptr && 
-    alloc_end   <  pool_end_ptr;
+void* __pool_realloc_in_place(Pool* pool, void* ptr, const u64 s_realloc) {
+  assert(pool != NULL);
+  assert(ptr != NULL);
+  assert(s_realloc > 0);
+
+  u64* s_ptr = (u64*)__alloc_utils_ptr_decr(ptr, S_WORD);
+
+  const u64
+    index      = __pool_get_index(pool, ptr),
+    blocks_old = __pool_bytes_to_block(pool, ALLOC_SIZE(*s_ptr, ptr)),
+    blocks_new = __pool_bytes_to_block(pool, s_realloc);
+
+  // shrink: keep the front, hand the tail blocks back
+  if (blocks_new <= blocks_old) {
+    if (blocks_new < blocks_old)
+      __pool_free_region_update(pool, index + blocks_new, blocks_old - blocks_new);
+
+    *s_ptr = ALLOC_HEADER(s_realloc);
+    return ptr;
+  }
+
+  // grow: claim the physically adjacent free region, if it is big enough
+  const u64
+    need  = blocks_new - blocks_old,
+    total = pool->s_pool / pool->s_block;
+
+  if (index + blocks_old >= total)
+    return NULL;
+
+  if (pool->bitmap != NULL) {
+    // the blocks to the right must exist and all be clear
+    if (
+      index + blocks_new > total ||
+      __pool_bitmap_test(pool, index + blocks_old, need)
+    )
+      return NULL;
+
+    __pool_bitmap_set(pool, index + blocks_old, need, true);
+
+    pool->s_blocks_used += need;
+    if (pool->s_blocks_used > pool->s_blocks_peak)
+      pool->s_blocks_peak = pool->s_blocks_used;
+
+    *s_ptr = ALLOC_HEADER(s_realloc);
+    return ptr;
+  }
+
+  FreeRegion* right = __pool_region_tag_read(
+    pool, __pool_block_ptr(pool, index + blocks_old)
+  );
+
+  if (right == NULL || right->start_block != index + blocks_old || right->s_blocks < need)
+    return NULL;
+
+  __pool_unlink_region(pool, right);
+
+  right->start_block += need;
+  right->s_blocks    -= need;
+
+  if (right->s_blocks > 0)
+    __pool_bin_insert(pool, right);
+  else
+    __pool_region_release(pool, right);
+
+  pool->s_blocks_used += need;
+  if (pool->s_blocks_used > pool->s_blocks_peak)
+    pool->s_blocks_peak = pool->s_blocks_used;
+
+  *s_ptr = ALLOC_HEADER(s_realloc);
+  return ptr;
 }
 
 bool __pool_free_region_find(Pool* pool, const u64 blocks, u64* index) {
   assert(pool != NULL);
-  
+
   if (blocks == 0)
     return false;
 
+  // cached bound: skip the whole search when the node cannot fit the request
+  if (blocks > pool->s_run_hint)
+    return false;
+
+  if (pool->bitmap != NULL) {
+    if (!__pool_bitmap_find(pool, blocks, index)) {
+      pool->s_run_hint = blocks - 1;
+      return false;
+    }
+
+    return true;
+  }
+
+  const u64 bin = __pool_bin_index(blocks);
+
+  u64 scanned = 0;
+
+  // the exact bin covers [2^bin, 2^(bin+1)): scan it for the tightest fit,
+  // stopping the moment the fit is exact — in bin 0 every region is exactly
+  // one block, so the hottest size class resolves at the bin head
+  FreeRegion* region = NULL;
+  for (FreeRegion* r = pool->bins[bin]; r != NULL; r = r->next) {
+    scanned++;
+
+    if (r->s_blocks == blocks) {
+      region = r;
+      break;
+    }
+
+    if (
+      r->s_blocks > blocks &&
+      (region == NULL || r->s_blocks < region->s_blocks)
+    )
+      region = r;
+  }
+
+  ALLOC_TRACE_COUNT(ALLOC_EVENT_POOL_SEARCH, scanned);
+  (void)scanned;
+
+  if (region == NULL) {
+    // any region in a larger non-empty bin fits: grab the lowest one's head
+    const u64 mask = bin + 1 >= S_POOL_BINS
+      ? 0
+      : pool->bin_mask & ~(((u64)1 << (bin + 1)) - 1);
+
+    if (mask == 0) {
+      // the search proved no run of this size exists: remember the bound
+      pool->s_run_hint = blocks - 1;
+      return false;
+    }
+
+    region = pool->bins[__alloc_utils_ctz(mask)];
+  }
+
+  *index = region->start_block;
+
+  __pool_unlink_region(pool, region);
+
+  region->start_block += blocks;
+  region->s_blocks    -= blocks;
+
+  if (region->s_blocks > 0)
+    __pool_bin_insert(pool, region);
+  else
+    __pool_region_release(pool, region);
+
+  pool->s_blocks_used += blocks;
+  if (pool->s_blocks_used > pool->s_blocks_peak)
+    pool->s_blocks_peak = pool->s_blocks_used;
+
+  return true;
+}
+
+bool __pool_free_region_find_aligned(Pool* pool, const u64 blocks, const u64 align, u64* index) {
+  assert(pool != NULL);
+
+  // user pointers are always S_WORD aligned: nothing extra to do
+  if (align <= S_WORD)
+    return __pool_free_region_find(pool, blocks, index);
+
+  // with S_WORD-sized blocks every user address is 8 mod 16, so no amount
+  // of slack can satisfy a larger alignment — reject instead of searching
+  if (pool->s_block == S_WORD)
+    return false;
+
+  /*
+   * User addresses step by (S_WORD + s_block) per block, which is an odd
+   * multiple of S_WORD for any s_block >= 2 * S_WORD, so within any
+   * align / S_WORD consecutive blocks one lands on an aligned address.
+   * Over-allocate that much slack, pick the aligned block, and hand the
+   * unused prefix/suffix straight back to the free list.
+   */
+  const u64 slack = align / S_WORD;
+
+  u64 start;
+  if (!__pool_free_region_find(pool, blocks + slack, &start))
+    return false;
+
+  const u64 base = (u64)(uintptr_t)__pool_get_base_ptr(pool);
+  const u64 stride = S_WORD + pool->s_block;
+
+  u64 block = start;
   for (
-    FreeRegion* region = pool->free_list; 
-    region != NULL;
-    region = region->next
-  ) {
-    if (region->s_blocks < blocks)
-      continue;
+    ;
+    block <= start + slack &&
+    (base + block * stride + S_WORD) % align != 0;
+    block++
+  );
 
-    *index = region->start_block;
-  
-    region->s_blocks -= blocks;
-    region->start_block += blocks;
+  if (block > start + slack) {
+    // not reachable with this stride (e.g. s_block == S_WORD): give it all back
+    __pool_free_region_update(pool, start, blocks + slack);
+    return false;
+  }
 
-    if (region->s_blocks == 0) {
-      __pool_unlink_region(pool, region);
-    } else {
-      for (
-        ;
-        region->prev != NULL &&
-        region->s_blocks < region->prev->s_blocks;
-        region = region->prev
-      ) {
-        __alloc_utils_swap(&region->start_block, &region->prev->start_block);
-        __alloc_utils_swap(&region->s_blocks, &region->prev->s_blocks);
-      }
-    } 
+  if (block > start)
+    __pool_free_region_update(pool, start, block - start);
 
-    return true;
-  }
+  const u64 tail = (start + blocks + slack) - (block + blocks);
+  if (tail > 0)
+    __pool_free_region_update(pool, block + blocks, tail);
 
-  return false;
+  *index = block;
+  return true;
 }
 
 void __pool_free_region_append(Pool* pool, const u64 s_blocks, const u64 start_block) {
   assert(pool != NULL);
   assert(s_blocks > 0);
 
-  FreeRegion
-    **node = &pool->free_list,
-    *prev  = NULL;
-  for (
-    ;
-    *node != NULL;
-    prev  = *node, *node = (*node)->next
-  );
-
-  *node = (FreeRegion*)arena_alloc(pool->fl_arena, sizeof(struct free_region));
-  assert(*node != NULL);
+  FreeRegion* region = __pool_region_acquire(pool);
+  assert(region != NULL);
 
-  **node = (FreeRegion) {
+  *region = (FreeRegion) {
     .start_block = start_block,
     .s_blocks    = s_blocks,
-    .prev        = prev,
+    .prev        = NULL,
     .next        = NULL
   };
+
+  __pool_bin_insert(pool, region);
+
+  if (s_blocks > pool->s_run_hint)
+    pool->s_run_hint = s_blocks;
 }
 
 bool __pool_free_region_update(Pool* pool, u64 index, u64 blocks) {
   assert(pool);
   assert(blocks > 0);
 
+  // bitmap mode: freeing is a bit clear, coalescing falls out for free
+  if (pool->bitmap != NULL) {
+    __pool_bitmap_set(pool, index, blocks, false);
+    pool->s_blocks_used -= blocks;
+
+    // the merged run size is not tracked here: fall back to "unknown" and
+    // let the next failed find tighten the bound again
+    pool->s_run_hint = pool->s_pool / pool->s_block;
+
+    return true;
+  }
+
   FreeRegion* left  = NULL;
   FreeRegion* right = NULL;
 
-  // 1. Find adjacent regions by scanning the size-sorted list
-  // We look for any region that ends where our new block starts (left)
-  // or starts where our new block ends (right).
-  for (FreeRegion* r = pool->free_list; r; r = r->next) {
-    if (__pool_region_end(r) == index)
+  const u64 total_blocks = pool->s_pool / pool->s_block;
+
+  // 1. Find adjacent regions through the boundary tags stored in block memory.
+  // A free region keeps a pointer to its descriptor in the first word of its
+  // first block and in the last word of its last block, so both physical
+  // neighbors are one validated load away — no free-list scan.
+  if (index > 0) {
+    void* footer = __alloc_utils_ptr_decr(__pool_block_ptr(pool, index), S_WORD);
+
+    FreeRegion* r = __pool_region_tag_read(pool, footer);
+    if (r != NULL && __pool_region_end(r) == index)
       left = r;
-    else if (r->start_block == index + blocks)
+  }
+
+  if (index + blocks < total_blocks) {
+    FreeRegion* r = __pool_region_tag_read(pool, __pool_block_ptr(pool, index + blocks));
+    if (r != NULL && r->start_block == index + blocks)
       right = r;
-    
-    if (left && right)
-      break;
   }
 
   // 2. Handle Merging
@@ -615,8 +2867,15 @@ bool __pool_free_region_update(Pool* pool, u64 index, u64 blocks) {
     __pool_unlink_region(pool, right);
 
     left->s_blocks += blocks + right->s_blocks;
-    
-    __pool_insert_region_sorted(pool, left);
+
+    __pool_region_release(pool, right);
+
+    __pool_bin_insert(pool, left);
+
+    pool->s_blocks_used -= blocks;
+
+    if (left->s_blocks > pool->s_run_hint)
+      pool->s_run_hint = left->s_blocks;
 
     return true;
   }
@@ -625,7 +2884,12 @@ bool __pool_free_region_update(Pool* pool, u64 index, u64 blocks) {
     // Case: [Left][Freed]
     __pool_unlink_region(pool, left);
     left->s_blocks += blocks;
-    __pool_insert_region_sorted(pool, left);
+    __pool_bin_insert(pool, left);
+
+    pool->s_blocks_used -= blocks;
+
+    if (left->s_blocks > pool->s_run_hint)
+      pool->s_run_hint = left->s_blocks;
 
     return true;
   }
@@ -635,14 +2899,21 @@ bool __pool_free_region_update(Pool* pool, u64 index, u64 blocks) {
     __pool_unlink_region(pool, right);
     right->start_block = index;
     right->s_blocks += blocks;
-    __pool_insert_region_sorted(pool, right);
+    __pool_bin_insert(pool, right);
+
+    pool->s_blocks_used -= blocks;
+
+    if (right->s_blocks > pool->s_run_hint)
+      pool->s_run_hint = right->s_blocks;
 
     return true;
   }
 
   // 3. No neighbors: Create a brand new region
-  FreeRegion* region = (FreeRegion*)arena_alloc(pool->fl_arena, sizeof(struct free_region));
-  assert(region);
+  FreeRegion* region = __pool_region_acquire(pool);
+  if (region == NULL)
+    // metadata arena exhausted: report failure; the blocks stay unusable until reset
+    return false;
 
   *region = (FreeRegion){
     .start_block = index,
@@ -651,45 +2922,375 @@ bool __pool_free_region_update(Pool* pool, u64 index, u64 blocks) {
     .next        = NULL
   };
 
-  __pool_insert_region_sorted(pool, region);
+  __pool_bin_insert(pool, region);
+
+  pool->s_blocks_used -= blocks;
+
+  if (blocks > pool->s_run_hint)
+    pool->s_run_hint = blocks;
+
+  return true;
+}
+
+// Private FixedPool
+
+bool __pool_fixed_ptr_in_pool(const FixedPool* pool, const void* ptr) {
+  assert(pool != NULL);
+  assert(ptr != NULL);
+
+  const u8
+    *base = pool->memory,
+    *end  = __alloc_utils_ptr_incr(base, pool->count * pool->s_obj);
+
+  if ((const u8*)ptr < base || (const u8*)ptr >= end)
+    return false;
+
+  // must sit exactly on a slot boundary
+  return (u64)__alloc_utils_ptr_diff(ptr, base) % pool->s_obj == 0;
+}
+
+bool __pool_magazine_refill(PoolMagazine* mag, const u64 class) {
+  assert(mag != NULL);
+  assert(class < S_MAG_CLASSES);
+
+  // one free-list search per round, but a batch of rounds per miss
+  const u64 s_class = (class + 1) * mag->pool->s_block;
+
+  for (u64 i = 0; i < S_MAG_ROUNDS / 2; i++) {
+    void* ptr = pool_alloc(mag->pool, s_class);
+    if (ptr == NULL)
+      break;
+
+    mag->rounds[class][mag->count[class]++] = ptr;
+  }
+
+  return mag->count[class] > 0;
+}
+
+void __pool_magazine_drain(PoolMagazine* mag, const u64 class, const u64 keep) {
+  assert(mag != NULL);
+  assert(class < S_MAG_CLASSES);
+
+  while (mag->count[class] > keep) {
+    void* ptr = mag->rounds[class][--mag->count[class]];
+    (void)pool_free(mag->pool, ptr);
+  }
+}
+
+static inline u64 __pool_bitmap_words(const Pool* pool) {
+  return (pool->s_pool / pool->s_block + 63) / 64;
+}
+
+void __pool_bitmap_pad(Pool* pool) {
+  assert(pool != NULL && pool->bitmap != NULL);
+
+  // mark the bits past the last real block as used so scans never cross them
+  const u64 tail = (pool->s_pool / pool->s_block) % 64;
+  if (tail != 0)
+    pool->bitmap[__pool_bitmap_words(pool) - 1] |= ~(((u64)1 << tail) - 1);
+}
+
+void __pool_bitmap_set(Pool* pool, u64 index, u64 blocks, const bool used) {
+  assert(pool != NULL && pool->bitmap != NULL);
+
+  while (blocks > 0) {
+    const u64
+      word = index / 64,
+      bit  = index % 64,
+      n    = __alloc_utils_min(64 - bit, blocks),
+      mask = (n == 64 ? (u64)-1 : (((u64)1 << n) - 1)) << bit;
+
+    if (used)
+      pool->bitmap[word] |= mask;
+    else
+      pool->bitmap[word] &= ~mask;
+
+    index  += n;
+    blocks -= n;
+  }
+}
+
+bool __pool_bitmap_test(const Pool* pool, u64 index, u64 blocks) {
+  assert(pool != NULL && pool->bitmap != NULL);
+
+  while (blocks > 0) {
+    const u64
+      word = index / 64,
+      bit  = index % 64,
+      n    = __alloc_utils_min(64 - bit, blocks),
+      mask = (n == 64 ? (u64)-1 : (((u64)1 << n) - 1)) << bit;
+
+    if (pool->bitmap[word] & mask)
+      return true;
+
+    index  += n;
+    blocks -= n;
+  }
+
+  return false;
+}
+
+bool __pool_bitmap_find(Pool* pool, const u64 blocks, u64* index) {
+  assert(pool != NULL && pool->bitmap != NULL);
+  assert(blocks > 0);
+
+  const u64 words = __pool_bitmap_words(pool);
+
+  u64 run = 0, start = 0;
+
+  for (u64 w = 0; w < words; w++) {
+    const u64 word = pool->bitmap[w];
+
+    // whole-word fast paths cover 64 blocks per compare
+    if (word == 0) {
+      if (run == 0)
+        start = w * 64;
+
+      run += 64;
+      if (run >= blocks)
+        goto found;
+
+      continue;
+    }
+
+    if (word == (u64)-1) {
+      run = 0;
+      continue;
+    }
+
+    // mixed word: hop between runs with ctz instead of testing every bit
+    for (u64 bit = 0; bit < 64; ) {
+      const u64 rest = word >> bit;
+
+      if (rest & 1) {
+        const u64 inv = ~rest;
+        bit = inv == 0 ? 64 : bit + __alloc_utils_ctz(inv);
+        run = 0;
+        continue;
+      }
+
+      if (run == 0)
+        start = w * 64 + bit;
+
+      const u64 zeros = rest == 0 ? 64 - bit : __alloc_utils_ctz(rest);
+
+      run += zeros;
+      bit += zeros;
+
+      if (run >= blocks)
+        goto found;
+    }
+  }
+
+  return false;
+
+found:
+  *index = start;
+
+  __pool_bitmap_set(pool, start, blocks, true);
+
+  pool->s_blocks_used += blocks;
+  if (pool->s_blocks_used > pool->s_blocks_peak)
+    pool->s_blocks_peak = pool->s_blocks_used;
+
   return true;
 }
 
+void __pool_bitmap_stats(const Pool* pool, u64* n_regions, u64* s_largest) {
+  assert(pool != NULL && pool->bitmap != NULL);
+  assert(n_regions != NULL && s_largest != NULL);
+
+  const u64 words = __pool_bitmap_words(pool);
+
+  u64 run = 0;
+
+  *n_regions = 0;
+  *s_largest = 0;
+
+  for (u64 w = 0; w < words; w++) {
+    const u64 word = pool->bitmap[w];
+
+    if (word == 0) {
+      run += 64;
+      continue;
+    }
+
+    for (u64 bit = 0; bit < 64; ) {
+      const u64 rest = word >> bit;
+
+      if (rest & 1) {
+        if (run > 0) {
+          (*n_regions)++;
+          *s_largest = __alloc_utils_max(*s_largest, run);
+          run = 0;
+        }
+
+        const u64 inv = ~rest;
+        bit = inv == 0 ? 64 : bit + __alloc_utils_ctz(inv);
+        continue;
+      }
+
+      const u64 zeros = rest == 0 ? 64 - bit : __alloc_utils_ctz(rest);
+
+      run += zeros;
+      bit += zeros;
+    }
+  }
+
+  if (run > 0) {
+    (*n_regions)++;
+    *s_largest = __alloc_utils_max(*s_largest, run);
+  }
+}
+
+void __pool_pending_flush(Pool* pool) {
+  assert(pool != NULL);
+
+  while (pool->pending != NULL) {
+    FreeRegion* r = pool->pending;
+    pool->pending = r->next;
+
+    const u64
+      index  = r->start_block,
+      blocks = r->s_blocks;
+
+    // recycle the descriptor first so the merge below can reuse it
+    __pool_region_release(pool, r);
+
+    (void)__pool_free_region_update(pool, index, blocks);
+  }
+
+  pool->n_pending = 0;
+}
+
+FreeRegion* __pool_region_acquire(Pool* pool) {
+  assert(pool != NULL);
+
+  FreeRegion* region = pool->fl_free;
+  if (region != NULL) {
+    pool->fl_free = region->next;
+    region->next  = NULL;
+    return region;
+  }
+
+  return (FreeRegion*)arena_alloc(pool->fl_arena, sizeof(struct free_region));
+}
+
+void __pool_region_release(Pool* pool, FreeRegion* region) {
+  assert(pool != NULL);
+  assert(region != NULL);
+
+  // poison so a stale boundary tag can never cross-check as adjacent
+  region->start_block = (u64)-1;
+  region->s_blocks    = 0;
+  region->prev        = NULL;
+
+  region->next  = pool->fl_free;
+  pool->fl_free = region;
+}
+
 static inline u64 __pool_region_end(const FreeRegion* region) {
   return region->start_block + region->s_blocks;
 }
 
+static inline u64 __pool_bin_index(const u64 s_blocks) {
+  assert(s_blocks > 0);
+  // floor(log2(s_blocks))
+  return (S_POOL_BINS - 1) - (u64)__builtin_clzll(s_blocks);
+}
+
 void __pool_unlink_region(Pool* pool, FreeRegion* region) {
+  const u64 bin = __pool_bin_index(region->s_blocks);
+
+  __pool_region_tag_clear(pool, region);
+
   if (region->prev)
     region->prev->next = region->next;
   else
-    pool->free_list = region->next;
+    pool->bins[bin] = region->next;
 
   if (region->next)
     region->next->prev = region->prev;
 
+  if (pool->bins[bin] == NULL)
+    pool->bin_mask &= ~((u64)1 << bin);
+
+  pool->n_regions--;
+
   region->prev = region->next = NULL;
 }
 
-void __pool_insert_region_sorted(Pool* pool, FreeRegion* region) {
-  FreeRegion* curr = pool->free_list;
-  FreeRegion* prev = NULL;
+void __pool_bin_insert(Pool* pool, FreeRegion* region) {
+  const u64 bin = __pool_bin_index(region->s_blocks);
 
-  while (curr && curr->s_blocks <= region->s_blocks) {
-    prev = curr;
-    curr = curr->next;
-  }
+  region->prev = NULL;
+  region->next = pool->bins[bin];
 
-  region->prev = prev;
-  region->next = curr;
+  if (pool->bins[bin])
+    pool->bins[bin]->prev = region;
 
-  if (prev)
-    prev->next = region;
-  else
-    pool->free_list = region;
+  pool->bins[bin] = region;
+  pool->bin_mask |= (u64)1 << bin;
+
+  pool->n_regions++;
 
-  if (curr)
-    curr->prev = region;
+  __pool_region_tag_write(pool, region);
+}
+
+static inline void* __pool_block_ptr(const Pool* pool, const u64 block) {
+  return __alloc_utils_ptr_incr(__pool_get_base_ptr(pool), block * (S_WORD + pool->s_block));
+}
+
+void __pool_region_tag_write(Pool* pool, const FreeRegion* region) {
+  assert(pool != NULL);
+  assert(region != NULL);
+
+  void
+    *head = __pool_block_ptr(pool, region->start_block),
+    *foot = __alloc_utils_ptr_decr(__pool_block_ptr(pool, __pool_region_end(region)), S_WORD);
+
+  *(const FreeRegion**)head = region;
+  *(const FreeRegion**)foot = region;
+}
+
+void __pool_region_tag_clear(Pool* pool, const FreeRegion* region) {
+  assert(pool != NULL);
+  assert(region != NULL);
+
+  void
+    *head = __pool_block_ptr(pool, region->start_block),
+    *foot = __alloc_utils_ptr_decr(__pool_block_ptr(pool, __pool_region_end(region)), S_WORD);
+
+  *(FreeRegion**)head = NULL;
+  *(FreeRegion**)foot = NULL;
+}
+
+FreeRegion* __pool_region_tag_read(const Pool* pool, void* tag_addr) {
+  assert(pool != NULL);
+  assert(tag_addr != NULL);
+
+  FreeRegion* region = *(FreeRegion**)tag_addr;
+  if (region == NULL)
+    return NULL;
+
+  /*
+   * When the neighboring block is live, tag_addr holds user data, so the
+   * loaded value may be anything. It is only safe to dereference once we
+   * know it points inside fl_arena's used extent — every real descriptor
+   * does, and the caller still cross-checks start/end adjacency after.
+   */
+  for (Arena* node = pool->fl_arena; node != NULL; node = node->next) {
+    const u8
+      *base = node->memory,
+      *end  = node->ptr,
+      *ptr  = (const u8*)region;
+
+    // compare by distance: ptr + sizeof could wrap for garbage tag values
+    if (ptr >= base && ptr < end && (u64)(end - ptr) >= sizeof(struct free_region))
+      return region;
+  }
+
+  return NULL;
 }
 
 static inline u64 __pool_size_memory(const Pool* pool) {
@@ -699,7 +3300,8 @@ static inline u64 __pool_size_memory(const Pool* pool) {
 }
 
 static inline u64 __pool_bytes_to_block(const Pool* pool, const u64 bytes) {
-  return __alloc_utils_ceil((f64)bytes / pool->s_block);
+  // s_block is a power of two: an add and a shift, no f64 round trip
+  return (bytes + pool->s_block - 1) >> __alloc_utils_ctz(pool->s_block);
 }
 
 u64 __pool_get_index(const Pool* pool, const void *ptr) {
@@ -719,6 +3321,182 @@ static inline void* __pool_get_base_ptr(const Pool* pool) {
   return pool->memory;
 }
 
+// Trace
+
+#ifdef ALLOC_TRACE
+
+static AllocHook __alloc_trace_hook     = NULL;
+static void*     __alloc_trace_hook_ctx = NULL;
+
+static u64 __alloc_trace_latency[64];
+static u64 __alloc_trace_size[64];
+static u64 __alloc_trace_search[64];
+
+u64 __alloc_trace_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+// bucket b counts values in [2^b, 2^(b+1)); 0 lands in bucket 0
+static inline u64 __alloc_trace_bucket(const u64 value) {
+  return value < 2 ? 0 : 63 - (u64)__builtin_clzll(value);
+}
+
+void __alloc_trace_event(const AllocEvent event, const u64 size, const u64 ns) {
+  switch (event) {
+    case ALLOC_EVENT_POOL_SEARCH:
+      __atomic_fetch_add(&__alloc_trace_search[__alloc_trace_bucket(size)], 1, __ATOMIC_RELAXED);
+      break;
+
+    case ALLOC_EVENT_ARENA_GROW:
+    case ALLOC_EVENT_POOL_GROW:
+      break; // growth is rare: hook-only, no histogram
+
+    default:
+      __atomic_fetch_add(&__alloc_trace_size[__alloc_trace_bucket(size)], 1, __ATOMIC_RELAXED);
+      __atomic_fetch_add(&__alloc_trace_latency[__alloc_trace_bucket(ns)], 1, __ATOMIC_RELAXED);
+      break;
+  }
+
+  AllocHook hook = __atomic_load_n(&__alloc_trace_hook, __ATOMIC_RELAXED);
+  if (hook != NULL)
+    hook(__atomic_load_n(&__alloc_trace_hook_ctx, __ATOMIC_RELAXED), event, size, ns);
+}
+
+void alloc_set_hook(AllocHook hook, void* ctx) {
+  __atomic_store_n(&__alloc_trace_hook_ctx, ctx, __ATOMIC_RELAXED);
+  __atomic_store_n(&__alloc_trace_hook, hook, __ATOMIC_RELEASE);
+}
+
+void alloc_get_histogram(AllocHistogram* out) {
+  if (out == NULL)
+    return;
+
+  for (u64 i = 0; i < 64; i++) {
+    out->latency[i] = __atomic_load_n(&__alloc_trace_latency[i], __ATOMIC_RELAXED);
+    out->size[i]    = __atomic_load_n(&__alloc_trace_size[i], __ATOMIC_RELAXED);
+    out->search[i]  = __atomic_load_n(&__alloc_trace_search[i], __ATOMIC_RELAXED);
+  }
+}
+
+void alloc_reset_histogram(void) {
+  for (u64 i = 0; i < 64; i++) {
+    __atomic_store_n(&__alloc_trace_latency[i], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&__alloc_trace_size[i], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&__alloc_trace_search[i], 0, __ATOMIC_RELAXED);
+  }
+}
+
+#endif // ALLOC_TRACE
+
+// Debug
+
+#ifdef ALLOC_DEBUG
+u64 __alloc_debug_size(const u64 header, const void* ptr) {
+  if (header == ALLOC_DEBUG_FREED) {
+    fprintf(stderr, "alloc: double free of %p\n", ptr);
+    abort();
+  }
+
+  if ((header & ALLOC_DEBUG_MASK) != ALLOC_DEBUG_CANARY) {
+    fprintf(
+      stderr,
+      "alloc: bad header canary at %p (word 0x%016llx): "
+      "stray pointer or buffer underrun\n",
+      ptr, (unsigned long long)header
+    );
+    abort();
+  }
+
+  return header & ~ALLOC_DEBUG_MASK;
+}
+#endif
+
+// Range Index
+
+bool __range_index_insert(RangeIndex* index, const void* base, const void* end, void* owner) {
+  assert(index != NULL);
+  assert(base != NULL && base < end && owner != NULL);
+
+  if (index->count == index->cap) {
+    const u64 cap = index->cap == 0 ? 4 : 2 * index->cap;
+
+    RangeEntry* entries = (RangeEntry*)realloc(index->entries, cap * sizeof(RangeEntry));
+    if (entries == NULL)
+      return false;
+
+    index->entries = entries;
+    index->cap     = cap;
+  }
+
+  // insertion slot: first entry with a greater base
+  u64 lo = 0, hi = index->count;
+  while (lo < hi) {
+    const u64 mid = lo + (hi - lo) / 2;
+    if (index->entries[mid].base < (const u8*)base)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  memmove(
+    &index->entries[lo + 1], &index->entries[lo],
+    (index->count - lo) * sizeof(RangeEntry)
+  );
+
+  index->entries[lo] = (RangeEntry){ .base = base, .end = end, .owner = owner };
+  index->count++;
+
+  return true;
+}
+
+void __range_index_remove(RangeIndex* index, const void* base) {
+  assert(index != NULL);
+
+  for (u64 i = 0; i < index->count; i++)
+    if (index->entries[i].base == (const u8*)base) {
+      memmove(
+        &index->entries[i], &index->entries[i + 1],
+        (index->count - i - 1) * sizeof(RangeEntry)
+      );
+
+      index->count--;
+      return;
+    }
+}
+
+void* __range_index_find(const RangeIndex* index, const void* ptr) {
+  assert(index != NULL);
+
+  if (ptr == NULL || index->count == 0)
+    return NULL;
+
+  // greatest base <= ptr, then a containment check against that entry's end
+  u64 lo = 0, hi = index->count;
+  while (lo < hi) {
+    const u64 mid = lo + (hi - lo) / 2;
+    if (index->entries[mid].base <= (const u8*)ptr)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (lo == 0)
+    return NULL;
+
+  const RangeEntry* entry = &index->entries[lo - 1];
+  return (const u8*)ptr < entry->end ? entry->owner : NULL;
+}
+
+void __range_index_dispose(RangeIndex* index) {
+  if (index == NULL)
+    return;
+
+  free(index->entries);
+  *index = (RangeIndex){ 0 };
+}
+
 // Utils
 
 static inline void* __alloc_utils_ptr_incr(const void* ptr, const u64 bytes) {
@@ -810,6 +3588,25 @@ u8 __arena_utils_bit_count(const u8 byte) {
   return count;
 }
 
+static inline u64 __alloc_utils_page_align(const u64 bytes) {
+  const u64 s_page = (u64)sysconf(_SC_PAGESIZE);
+  return (bytes + s_page - 1) & ~(s_page - 1);
+}
+
+static inline bool __alloc_utils_is_power_2(const u64 s) {
+  return s != 0 && (s & (s - 1)) == 0;
+}
+
+static inline u64 __alloc_utils_align_up(const u64 s, const u64 align) {
+  assert(__alloc_utils_is_power_2(align));
+  return (s + align - 1) & ~(align - 1);
+}
+
+static inline u64 __alloc_utils_ctz(const u64 s) {
+  assert(s != 0);
+  return (u64)__builtin_ctzll(s);
+}
+
 static inline u64 __alloc_utils_ceil(const f64 x) {
   return (u64)x + (x > (f64)((u64)x) ? 1 : 0);
 }